@@ -21,6 +21,14 @@ typedef enum {
   E_CCURSOR_ERR_PARSE = -4,          /**< Parsing error */
 } ccursor_ret_t;
 
+/**
+ * @brief Handling of fraction digits beyond the requested decimal scale
+ */
+typedef enum {
+  E_CCURSOR_DECIMAL_TRUNCATE = 0, /**< Drop surplus digits */
+  E_CCURSOR_DECIMAL_ROUND = 1,    /**< Round half away from zero */
+} ccursor_decimal_mode_t;
+
 /**
  * @brief Helper macros to check if parsing failed
  *
@@ -29,6 +37,20 @@ typedef enum {
  */
 #define CCURSOR_IS_ERROR(ret) (((int8_t)(ret)) < ((int8_t)0))
 
+/**
+ * @brief Linkage of the hot primitives
+ *
+ * Define CCURSOR_HEADER_ONLY before including this header to get the hot
+ * primitives of ccursor_inline.h as static inline functions. This allows the
+ * compiler to fold them into the parse loops of the caller and to drop
+ * redundant checks. All other functions remain part of the library.
+ */
+#if defined(CCURSOR_HEADER_ONLY)
+#define CCURSOR_HOT static inline
+#else
+#define CCURSOR_HOT
+#endif
+
 /**
  * @brief Helper macros to check if parsing was successful
  *
@@ -50,6 +72,149 @@ typedef struct {
   char *read_position;
 } ccursor_handle_t;
 
+/**
+ * @brief Window of a char cursor reserved for unchecked reads
+ *
+ * Obtained via ccursor_reserve, see ccursor_unchecked.h for the primitives.
+ */
+typedef struct {
+  char *read_position; /**< Next character of the window */
+  char *end;           /**< End of the reserved window */
+} ccursor_unchecked_t;
+
+// maximum number of fields of a record indexed by ccursor_index_fields
+#define CCURSOR_MAX_FIELDS 64
+
+/**
+ * @brief Field offsets of a single record
+ *
+ * Filled by ccursor_index_fields, the fields are parsed on demand via
+ * ccursor_field_u32 or ccursor_field_view.
+ */
+typedef struct {
+  char *record; /**< First character of the record */
+  size_t count; /**< Number of fields */
+  uint32_t starts[CCURSOR_MAX_FIELDS + 1]; /**< Field offsets, plus the end */
+} ccursor_field_index_t;
+
+/**
+ * @brief Value types of projected columns
+ */
+typedef enum {
+  E_CCURSOR_COLUMN_U32 = 0,     /**< uint32_t, see ccursor_read_u32 */
+  E_CCURSOR_COLUMN_I32 = 1,     /**< int32_t, see ccursor_read_i32 */
+  E_CCURSOR_COLUMN_F64 = 2,     /**< double, see ccursor_read_f64 */
+  E_CCURSOR_COLUMN_DECIMAL = 3, /**< int64_t, see ccursor_read_decimal */
+} ccursor_column_type_t;
+
+/**
+ * @brief Output array of a projected column
+ */
+typedef struct {
+  ccursor_column_type_t type; /**< Value type of the column */
+  uint8_t scale;              /**< Fraction digits of decimal columns */
+  void *values;               /**< Array of the value type, one per row */
+} ccursor_column_t;
+
+/**
+ * @brief Column projection of delimited lines into a struct of arrays
+ */
+typedef struct {
+  uint64_t selected;          /**< [in] Bit i selects column i */
+  ccursor_column_t *columns;  /**< [in] One entry per selected column */
+  size_t capacity;            /**< [in] Number of rows each array can hold */
+  size_t rows;                /**< [out] Number of projected rows */
+} ccursor_projection_t;
+
+// maximum number of trie nodes of a prefix set, including the root
+#define CCURSOR_PREFIX_MAX_NODES 512
+
+/**
+ * @brief Node of the prefix trie, the children of a node are stored one
+ *        after another and sorted by their label
+ */
+typedef struct {
+  uint16_t children; /**< Index of the first child */
+  uint8_t count;     /**< Number of children, at most 255 */
+  uint8_t label;     /**< Character leading to this node */
+  int16_t prefix;    /**< Index of the prefix ending here, or -1 */
+} ccursor_prefix_node_t;
+
+/**
+ * @brief Byte trie over a table of prefixes, see ccursor_prefix_init
+ */
+typedef struct {
+  ccursor_prefix_node_t nodes[CCURSOR_PREFIX_MAX_NODES]; /**< Root first */
+  size_t node_count;                                     /**< Used nodes */
+} ccursor_prefix_set_t;
+
+/**
+ * @brief Class of characters, see ccursor_charset_init
+ *
+ * Besides the bitmap, a class is described by two nibble tables: a character
+ * is a member if the groups of its low and its high nibble intersect. This
+ * is exact for classes of at most 8 distinct rows of the 16x16 character
+ * table, which covers the usual classes like digits, hex digits or
+ * separators, and lets the SIMD kernels classify a block with two shuffles.
+ */
+typedef struct {
+  uint64_t bits[4]; /**< Membership of each character */
+  uint8_t low[16];  /**< Groups containing each low nibble */
+  uint8_t high[16]; /**< Group of each high nibble */
+  bool nibbles;     /**< The nibble tables describe the class exactly */
+} ccursor_charset_t;
+
+// maximum number of keywords of a keyword set and their hash slots
+#define CCURSOR_KEYWORD_MAX 128
+#define CCURSOR_KEYWORD_SLOTS 256
+
+/**
+ * @brief Entry of a keyword table
+ */
+typedef struct {
+  const char *keyword; /**< Keyword, not empty and at most 255 characters */
+  uint32_t value;      /**< Value the keyword maps to */
+} ccursor_keyword_t;
+
+/**
+ * @brief Perfect hash of a keyword table, see ccursor_keyword_init
+ *
+ * The keywords are hashed with a seed into buckets, and the displacement of
+ * each bucket moves its keywords into free slots (CHD), so every keyword
+ * owns a slot of its own.
+ */
+typedef struct {
+  const ccursor_keyword_t *table;              /**< Keyword table */
+  uint64_t seed;                               /**< Seed of the hash */
+  uint32_t buckets;                            /**< Number of buckets */
+  uint32_t mask;                               /**< Slots minus one */
+  size_t max_length;                           /**< Longest keyword */
+  char sep;                                    /**< Keyword terminator */
+  uint16_t displacements[CCURSOR_KEYWORD_MAX]; /**< Per bucket */
+  int16_t slots[CCURSOR_KEYWORD_SLOTS];        /**< Table index or -1 */
+  uint8_t lengths[CCURSOR_KEYWORD_SLOTS];      /**< Keyword lengths */
+} ccursor_keyword_set_t;
+
+/**
+ * @brief Aggregates of a number stream
+ *
+ * Configure the input fields and zero the output fields before the first
+ * call of ccursor_aggregate_numbers. Further calls keep accumulating, which
+ * allows to aggregate a stream chunk by chunk.
+ */
+typedef struct {
+  uint8_t scale;               /**< [in] Fraction digits, 0 for integers */
+  ccursor_decimal_mode_t mode; /**< [in] Handling of surplus digits */
+  uint32_t *histogram;         /**< [in] Optional bucket counters or NULL */
+  size_t histogram_buckets;    /**< [in] Number of histogram buckets */
+  int64_t histogram_min;       /**< [in] Lower bound of the first bucket */
+  int64_t histogram_width;     /**< [in] Width of a single bucket */
+  uint64_t count;              /**< [out] Number of aggregated values */
+  int64_t sum;                 /**< [out] Sum of the values */
+  int64_t min;                 /**< [out] Smallest value */
+  int64_t max;                 /**< [out] Largest value */
+} ccursor_stats_t;
+
 /**
  * @brief Macro to define a single shot char cursor handle
  *
@@ -84,7 +249,18 @@ ccursor_ret_t ccursor_init(ccursor_handle_t *handle, char *buffer,
  * @param[in]     handle        - The char cursor handle
  * @return The number of available characters in the buffer
  */
-size_t ccursor_available(ccursor_handle_t *handle);
+CCURSOR_HOT size_t ccursor_available(ccursor_handle_t *handle);
+
+/**
+ * @brief Retrieves the instruction set used by the scanning kernels
+ *
+ * The widest instruction set supported by the CPU is selected once when the
+ * library is loaded. The environment variable CCURSOR_FORCE_ISA limits the
+ * selection to "scalar", "sse2", "avx2" or "avx512", if supported.
+ *
+ * @return The name of the active instruction set
+ */
+const char *ccursor_active_isa(void);
 
 /**
  * @brief Checks if the stream is empty
@@ -97,7 +273,25 @@ size_t ccursor_available(ccursor_handle_t *handle);
  * @return E_CCURSOR_ERR_PARAM if the handle is NULL
  * @return E_CCURSOR_ERR if the stream is not empty
  */
-ccursor_ret_t ccursor_is_empty(ccursor_handle_t *handle);
+CCURSOR_HOT ccursor_ret_t ccursor_is_empty(ccursor_handle_t *handle);
+
+/**
+ * @brief Reserves a number of characters for unchecked reads
+ *
+ * This function checks once that size characters are available, hands them
+ * out as window and advances the char cursor handle behind them. The
+ * unchecked primitives of ccursor_unchecked.h then read the window without
+ * any per-call checks, e.g. to decode a fixed-layout record.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     size          - The number of characters to reserve
+ * @param[out]    window        - The reserved window
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or window is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than size characters are available
+ */
+ccursor_ret_t ccursor_reserve(ccursor_handle_t *handle, size_t size,
+                              ccursor_unchecked_t *window);
 
 /**
  * @brief Retrieves a 32-bit unsigned integer from the stream
@@ -183,6 +377,454 @@ ccursor_ret_t ccursor_read_i16(ccursor_handle_t *handle, int16_t *value);
  */
 ccursor_ret_t ccursor_read_i8(ccursor_handle_t *handle, int8_t *value);
 
+/**
+ * @brief Retrieves a double precision floating point value from the stream
+ *
+ * This function retrieves a correctly rounded double from the char cursor
+ * handle. It accepts an optional sign, digits with an optional fraction and
+ * an optional exponent (e.g. "-12.5e3"). The conversion never reads beyond
+ * the cursor end and does not depend on the current locale. It advances the
+ * current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved double
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE on error or if the value overflows
+ */
+ccursor_ret_t ccursor_read_f64(ccursor_handle_t *handle, double *value);
+
+/**
+ * @brief Retrieves a single precision floating point value from the stream
+ *
+ * This function retrieves a correctly rounded float from the char cursor
+ * handle. See ccursor_read_f64 for the accepted format. It advances the
+ * current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved float
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE on error or if the value overflows
+ */
+ccursor_ret_t ccursor_read_f32(ccursor_handle_t *handle, float *value);
+
+/**
+ * @brief Retrieves a fixed-point decimal from the stream as scaled integer
+ *
+ * This function retrieves a decimal number (e.g. "-73.25") from the char
+ * cursor handle and stores it multiplied by 10^scale, without a detour via
+ * floating point. Fraction digits beyond the scale are truncated or rounded
+ * according to mode. It advances the current position in the buffer
+ * accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     scale         - The number of fraction digits to keep (0-18)
+ * @param[in]     mode          - The handling of surplus fraction digits
+ * @param[out]    value         - The retrieved value scaled by 10^scale
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL or the scale is
+ *         out of range
+ * @return E_CCURSOR_ERR_PARSE on error or if the scaled value overflows
+ */
+ccursor_ret_t ccursor_read_decimal(ccursor_handle_t *handle, uint8_t scale,
+                                   ccursor_decimal_mode_t mode,
+                                   int64_t *value);
+
+/**
+ * @brief Retrieves a delimited list of 32-bit unsigned integers
+ *
+ * This function retrieves numbers separated by sep (e.g. "1,0,3,0,1") from
+ * the char cursor handle in a single call. Each element follows the syntax
+ * of ccursor_read_u32. Reading stops after max elements or at the first
+ * element which cannot be parsed, a separator is only consumed together with
+ * the element following it. It advances the current position in the buffer
+ * behind the last parsed element.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     sep           - The separator between the elements
+ * @param[out]    values        - The retrieved values
+ * @param[in]     max           - The capacity of values
+ * @param[out]    count         - The number of retrieved values
+ * @return E_CCURSOR_RET_OK if at least one element was retrieved
+ * @return E_CCURSOR_ERR_PARAM if the handle, values or count is NULL or max
+ *         is zero
+ * @return E_CCURSOR_ERR_PARSE if the first element cannot be parsed
+ */
+ccursor_ret_t ccursor_read_u32_list(ccursor_handle_t *handle, char sep,
+                                    uint32_t *values, size_t max,
+                                    size_t *count);
+
+/**
+ * @brief Retrieves a delimited list of 32-bit signed integers
+ *
+ * This function retrieves numbers separated by sep from the char cursor
+ * handle, each element follows the syntax of ccursor_read_i32. See
+ * ccursor_read_u32_list for the handling of the list.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     sep           - The separator between the elements
+ * @param[out]    values        - The retrieved values
+ * @param[in]     max           - The capacity of values
+ * @param[out]    count         - The number of retrieved values
+ * @return E_CCURSOR_RET_OK if at least one element was retrieved
+ * @return E_CCURSOR_ERR_PARAM if the handle, values or count is NULL or max
+ *         is zero
+ * @return E_CCURSOR_ERR_PARSE if the first element cannot be parsed
+ */
+ccursor_ret_t ccursor_read_i32_list(ccursor_handle_t *handle, char sep,
+                                    int32_t *values, size_t max,
+                                    size_t *count);
+
+/**
+ * @brief Retrieves a delimited list of hex encoded 32-bit unsigned integers
+ *
+ * This function retrieves hex numbers separated by sep from the char cursor
+ * handle, each element follows the syntax of ccursor_read_u32_be. See
+ * ccursor_read_u32_list for the handling of the list.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     sep           - The separator between the elements
+ * @param[out]    values        - The retrieved values
+ * @param[in]     max           - The capacity of values
+ * @param[out]    count         - The number of retrieved values
+ * @return E_CCURSOR_RET_OK if at least one element was retrieved
+ * @return E_CCURSOR_ERR_PARAM if the handle, values or count is NULL or max
+ *         is zero
+ * @return E_CCURSOR_ERR_PARSE if the first element cannot be parsed
+ */
+ccursor_ret_t ccursor_read_hex_list(ccursor_handle_t *handle, char sep,
+                                    uint32_t *values, size_t max,
+                                    size_t *count);
+
+/**
+ * @brief Aggregates a delimited stream of numbers without storing them
+ *
+ * This function parses numbers separated by sep (e.g. one per line with
+ * '\n') from the char cursor handle and folds them into the count, sum, min
+ * and max of stats, plus the optional histogram, in a single pass. Each
+ * element follows the syntax of ccursor_read_decimal with the scale of
+ * stats, a '\r' in front of a '\n' separator is skipped. Values outside of
+ * the histogram range are counted in the first or last bucket. Aggregation
+ * stops at the first element which cannot be parsed or would overflow the
+ * sum, a separator is only consumed together with the element following it.
+ * It advances the current position in the buffer behind the last aggregated
+ * element.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     sep           - The separator between the elements
+ * @param[in,out] stats         - The aggregates to update
+ * @return E_CCURSOR_RET_OK if at least one element was aggregated
+ * @return E_CCURSOR_ERR_PARAM if the handle or stats is NULL or the scale or
+ *         histogram configuration is invalid
+ * @return E_CCURSOR_ERR_PARSE if the first element cannot be aggregated
+ */
+ccursor_ret_t ccursor_aggregate_numbers(ccursor_handle_t *handle, char sep,
+                                        ccursor_stats_t *stats);
+
+/**
+ * @brief Retrieves the next line of the stream without copying it
+ *
+ * This function returns the characters up to the next '\n' or the end of
+ * the stream as char cursor handle, which works with every reader of this
+ * library. The '\n' and a '\r' in front of it are not part of the line. It
+ * advances the current position in the buffer behind the '\n'.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    line          - The handle of the line, possibly empty
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or line is NULL or the stream is
+ *         empty
+ */
+ccursor_ret_t ccursor_next_line(ccursor_handle_t *handle,
+                                ccursor_handle_t *line);
+
+/**
+ * @brief Creates a child cursor over the next characters of the stream
+ *
+ * The child shares the buffer of the parent but ends after size characters,
+ * so a nested structure is parsed in place without copying it. The current
+ * position of the parent is not changed, see ccursor_commit.
+ *
+ * @param[in]     handle        - The char cursor handle of the parent
+ * @param[in]     size          - The number of characters of the child
+ * @param[out]    child         - The handle of the child, possibly empty
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or child is NULL or the stream is
+ *         empty
+ * @return E_CCURSOR_ERR_PARSE if the stream has less than size characters
+ */
+ccursor_ret_t ccursor_subview(const ccursor_handle_t *handle, size_t size,
+                              ccursor_handle_t *child);
+
+/**
+ * @brief Creates a child cursor over the characters up to a character
+ *
+ * The child covers the characters in front of the next occurrence of c, e.g.
+ * the elements of "(1,\"A\",2)" up to the ')'. The current position of the
+ * parent is not changed, see ccursor_commit.
+ *
+ * @param[in]     handle        - The char cursor handle of the parent
+ * @param[in]     c             - The character ending the child
+ * @param[out]    child         - The handle of the child, possibly empty
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or child is NULL or the stream is
+ *         empty
+ * @return E_CCURSOR_ERR_PARSE if the character is not found
+ */
+ccursor_ret_t ccursor_split_at_char(const ccursor_handle_t *handle, uint8_t c,
+                                    ccursor_handle_t *child);
+
+/**
+ * @brief Advances the parent cursor to the current position of a child
+ *
+ * @param[in,out] handle        - The char cursor handle of the parent
+ * @param[in]     child         - The handle of the child
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or child is NULL or the position
+ *         of the child is not within the remaining stream of the parent
+ */
+ccursor_ret_t ccursor_commit(ccursor_handle_t *handle,
+                             const ccursor_handle_t *child);
+
+/**
+ * @brief Skips a bracketed structure including its nested ones
+ *
+ * The stream has to start with the opening bracket, e.g. a list of
+ * +COPS=? like "(2,\"Op (1)\",\"O1\",\"26201\",7),(...)". Brackets
+ * within quotes are ignored, quotes are not escaped. It advances the current
+ * position in the buffer behind the matching closing bracket.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     open          - The opening bracket
+ * @param[in]     close         - The closing bracket
+ * @param[in]     quote         - The quote character, or '\0' for none
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle is NULL, the stream is empty or
+ *         the characters are not distinct
+ * @return E_CCURSOR_ERR_PARSE if the stream does not start with open or the
+ *         matching bracket is not found
+ */
+ccursor_ret_t ccursor_skip_balanced(ccursor_handle_t *handle, char open,
+                                    char close, char quote);
+
+/**
+ * @brief Counts the remaining lines of the stream
+ *
+ * This function counts the lines ccursor_next_line would return, e.g. to
+ * size output arrays up front. It does not advance the current position.
+ *
+ * @param[in]     handle        - The char cursor handle
+ * @param[out]    count         - The number of remaining lines
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or count is NULL or the stream is
+ *         empty
+ */
+ccursor_ret_t ccursor_count_lines(ccursor_handle_t *handle, size_t *count);
+
+/**
+ * @brief Indexes the fields of a record without parsing them
+ *
+ * This function scans a single record, which ends at the next '\n' or the
+ * end of the stream, for the field separator sep and records the offset of
+ * each field. A '\r' in front of the '\n' is not part of the last field.
+ * The fields are parsed on demand afterwards, such that unused fields only
+ * cost the separator scan. It advances the current position in the buffer
+ * behind the record including its '\n'.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     sep           - The field separator, must not be '\n'
+ * @param[out]    index         - The field index of the record
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or index is NULL or sep is '\n'
+ * @return E_CCURSOR_ERR_PARSE if the record has more than CCURSOR_MAX_FIELDS
+ *         fields
+ */
+ccursor_ret_t ccursor_index_fields(ccursor_handle_t *handle, char sep,
+                                   ccursor_field_index_t *index);
+
+/**
+ * @brief Retrieves a field of an indexed record as char cursor handle
+ *
+ * The returned handle covers the field only and works with every reader of
+ * this library. An empty field results in an empty handle.
+ *
+ * @param[in]     index         - The field index of the record
+ * @param[in]     field         - The number of the field, starting at 0
+ * @return The handle of the field, a handle without buffer if the field does
+ *         not exist
+ */
+ccursor_handle_t ccursor_field_view(const ccursor_field_index_t *index,
+                                    size_t field);
+
+/**
+ * @brief Parses a field of an indexed record as uint32_t
+ *
+ * The field follows the syntax of ccursor_read_u32 and has to consist of the
+ * number only.
+ *
+ * @param[in]     index         - The field index of the record
+ * @param[in]     field         - The number of the field, starting at 0
+ * @param[out]    value         - The parsed value
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the index or value is NULL or the field does
+ *         not exist
+ * @return E_CCURSOR_ERR_PARSE if the field is not a valid uint32_t
+ */
+ccursor_ret_t ccursor_field_u32(const ccursor_field_index_t *index,
+                                size_t field, uint32_t *value);
+
+/**
+ * @brief Projects selected columns of delimited lines into arrays
+ *
+ * This function reads lines of fields separated by sep and decodes the
+ * columns selected by the bit mask of projection into the arrays of its
+ * columns, in ascending column order. Unselected columns are skipped by
+ * counting separators 64 characters at a time, without looking at their
+ * content. A selected field has to consist of its value only. Reading stops
+ * when the capacity is reached, at the end of the stream or in front of the
+ * first line which cannot be projected, e.g. because it has too few columns.
+ * It advances the current position in the buffer behind the last projected
+ * line.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     sep           - The field separator, must not be '\n'
+ * @param[in,out] projection    - The projection configuration and result
+ * @return E_CCURSOR_RET_OK if at least one line was projected
+ * @return E_CCURSOR_ERR_PARAM if the handle, projection or its columns is
+ *         NULL, no column is selected, the capacity is zero or sep is '\n'
+ * @return E_CCURSOR_ERR_PARSE if the first line cannot be projected
+ */
+ccursor_ret_t ccursor_project_columns(ccursor_handle_t *handle, char sep,
+                                      ccursor_projection_t *projection);
+
+/**
+ * @brief Builds a prefix set from a table of prefixes
+ *
+ * This function builds a byte trie of the prefixes once, e.g. of the URCs
+ * "+CREG:", "+CGREG:" and "+CSQ:" a modem may send. ccursor_skip_prefix then
+ * identifies the prefix of a line in a single pass over its characters.
+ *
+ * @param[out]    set           - The prefix set
+ * @param[in]     prefixes      - The table of prefixes, not empty and unique
+ * @param[in]     count         - The number of prefixes
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the set is NULL, prefixes is NULL while
+ *         count is not 0, a prefix is empty or duplicated, or the trie
+ *         exceeds CCURSOR_PREFIX_MAX_NODES
+ */
+ccursor_ret_t ccursor_prefix_init(ccursor_prefix_set_t *set,
+                                  const char *const *prefixes, size_t count);
+
+/**
+ * @brief Skips the longest prefix of a prefix set at the beginning of the
+ *        stream
+ *
+ * This function walks the trie along the stream, such that the costs only
+ * depend on the length of the matched prefix and not on the number of
+ * prefixes. It advances the current position in the buffer behind the
+ * prefix.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     set           - The prefix set
+ * @param[out]    index         - The table index of the matched prefix
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle, set or index is NULL or the
+ *         stream is empty
+ * @return E_CCURSOR_ERR_PARSE if no prefix matches
+ */
+ccursor_ret_t ccursor_skip_prefix(ccursor_handle_t *handle,
+                                  const ccursor_prefix_set_t *set,
+                                  size_t *index);
+
+/**
+ * @brief Builds a character class from a specification
+ *
+ * The specification lists the members, "a-z" adds a range of characters and
+ * '\\' takes the next character literally, e.g. "0-9a-fA-F" or ",;\r\n". A
+ * '-' at the beginning or the end is a member itself.
+ *
+ * @param[out]    set           - The character class
+ * @param[in]     spec          - The specification
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if set or spec is NULL, a range is reversed or
+ *         the specification ends with a single '\\'
+ */
+ccursor_ret_t ccursor_charset_init(ccursor_charset_t *set, const char *spec);
+
+/**
+ * @brief Skips the characters of a class at the beginning of the stream
+ *
+ * This function advances the current position in the buffer to the first
+ * character which is no member of the class, or to the end of the stream.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     set           - The character class
+ * @param[out]    length        - The number of skipped characters, or NULL
+ * @return E_CCURSOR_RET_OK on success, also if no character was skipped
+ * @return E_CCURSOR_ERR_PARAM if the handle or set is NULL or the stream is
+ *         empty
+ */
+ccursor_ret_t ccursor_span(ccursor_handle_t *handle,
+                           const ccursor_charset_t *set, size_t *length);
+
+/**
+ * @brief Skips characters until a character of a class is found
+ *
+ * This function advances the current position in the buffer to the first
+ * member of the class, which is not skipped, or to the end of the stream.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     set           - The character class
+ * @param[out]    length        - The number of skipped characters, or NULL
+ * @return E_CCURSOR_RET_OK on success, also if no character was skipped
+ * @return E_CCURSOR_ERR_PARAM if the handle or set is NULL or the stream is
+ *         empty
+ */
+ccursor_ret_t ccursor_cspan(ccursor_handle_t *handle,
+                            const ccursor_charset_t *set, size_t *length);
+
+/**
+ * @brief Builds a keyword set from a table of keywords and their values
+ *
+ * This function searches a perfect hash of the keywords once, e.g. of the
+ * states "READY", "SIM PIN" and "SIM PUK" of +CPIN. ccursor_read_keyword then
+ * maps a token to its value with a single hash and compare.
+ *
+ * @param[out]    set           - The keyword set
+ * @param[in]     table         - The keyword table, it has to outlive the set
+ * @param[in]     count         - The number of keywords
+ * @param[in]     sep           - The character terminating a keyword
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the set or table is NULL, there are more than
+ *         CCURSOR_KEYWORD_MAX keywords or a keyword is empty, too long,
+ *         duplicated or contains sep
+ * @return E_CCURSOR_ERR if no perfect hash was found
+ */
+ccursor_ret_t ccursor_keyword_init(ccursor_keyword_set_t *set,
+                                   const ccursor_keyword_t *table,
+                                   size_t count, char sep);
+
+/**
+ * @brief Retrieves the value of a keyword from the stream
+ *
+ * The token reaches up to the separator of the set or the end of the stream.
+ * It is hashed and compared in place, such that the costs do not depend on
+ * the number of keywords. It advances the current position in the buffer
+ * behind the separator.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     set           - The keyword set
+ * @param[out]    value         - The value of the keyword
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle, set or value is NULL or the
+ *         stream is empty
+ * @return E_CCURSOR_ERR_PARSE if the token is no keyword
+ */
+ccursor_ret_t ccursor_read_keyword(ccursor_handle_t *handle,
+                                   const ccursor_keyword_set_t *set,
+                                   uint32_t *value);
+
 /**
  * @brief Retrieves a 32-bit unsigned integer from the stream as little-endian
  *
@@ -363,6 +1005,382 @@ ccursor_ret_t ccursor_read_i16_be(ccursor_handle_t *handle, int16_t *value);
  */
 ccursor_ret_t ccursor_read_i8_be(ccursor_handle_t *handle, int8_t *value);
 
+/**
+ * @brief Retrieves a raw little-endian 16-bit unsigned integer from the stream
+ *
+ * This function retrieves 2 raw bytes from the char cursor handle and
+ * interprets them as little-endian 16-bit unsigned integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 16-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 2 bytes are available
+ */
+ccursor_ret_t ccursor_get_u16_le(ccursor_handle_t *handle, uint16_t *value);
+
+/**
+ * @brief Retrieves a raw big-endian 16-bit unsigned integer from the stream
+ *
+ * This function retrieves 2 raw bytes from the char cursor handle and
+ * interprets them as big-endian 16-bit unsigned integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 16-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 2 bytes are available
+ */
+ccursor_ret_t ccursor_get_u16_be(ccursor_handle_t *handle, uint16_t *value);
+
+/**
+ * @brief Retrieves a raw little-endian 16-bit signed integer from the stream
+ *
+ * This function retrieves 2 raw bytes from the char cursor handle and
+ * interprets them as little-endian 16-bit signed integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 16-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 2 bytes are available
+ */
+ccursor_ret_t ccursor_get_i16_le(ccursor_handle_t *handle, int16_t *value);
+
+/**
+ * @brief Retrieves a raw big-endian 16-bit signed integer from the stream
+ *
+ * This function retrieves 2 raw bytes from the char cursor handle and
+ * interprets them as big-endian 16-bit signed integer. In contrast to the text
+ * based readers no characters are parsed. It advances the current position in
+ * the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 16-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 2 bytes are available
+ */
+ccursor_ret_t ccursor_get_i16_be(ccursor_handle_t *handle, int16_t *value);
+
+/**
+ * @brief Retrieves a raw little-endian 32-bit unsigned integer from the stream
+ *
+ * This function retrieves 4 raw bytes from the char cursor handle and
+ * interprets them as little-endian 32-bit unsigned integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 32-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 4 bytes are available
+ */
+ccursor_ret_t ccursor_get_u32_le(ccursor_handle_t *handle, uint32_t *value);
+
+/**
+ * @brief Retrieves a raw big-endian 32-bit unsigned integer from the stream
+ *
+ * This function retrieves 4 raw bytes from the char cursor handle and
+ * interprets them as big-endian 32-bit unsigned integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 32-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 4 bytes are available
+ */
+ccursor_ret_t ccursor_get_u32_be(ccursor_handle_t *handle, uint32_t *value);
+
+/**
+ * @brief Retrieves a raw little-endian 32-bit signed integer from the stream
+ *
+ * This function retrieves 4 raw bytes from the char cursor handle and
+ * interprets them as little-endian 32-bit signed integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 32-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 4 bytes are available
+ */
+ccursor_ret_t ccursor_get_i32_le(ccursor_handle_t *handle, int32_t *value);
+
+/**
+ * @brief Retrieves a raw big-endian 32-bit signed integer from the stream
+ *
+ * This function retrieves 4 raw bytes from the char cursor handle and
+ * interprets them as big-endian 32-bit signed integer. In contrast to the text
+ * based readers no characters are parsed. It advances the current position in
+ * the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 32-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 4 bytes are available
+ */
+ccursor_ret_t ccursor_get_i32_be(ccursor_handle_t *handle, int32_t *value);
+
+/**
+ * @brief Retrieves a raw little-endian 64-bit unsigned integer from the stream
+ *
+ * This function retrieves 8 raw bytes from the char cursor handle and
+ * interprets them as little-endian 64-bit unsigned integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 64-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 8 bytes are available
+ */
+ccursor_ret_t ccursor_get_u64_le(ccursor_handle_t *handle, uint64_t *value);
+
+/**
+ * @brief Retrieves a raw big-endian 64-bit unsigned integer from the stream
+ *
+ * This function retrieves 8 raw bytes from the char cursor handle and
+ * interprets them as big-endian 64-bit unsigned integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 64-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 8 bytes are available
+ */
+ccursor_ret_t ccursor_get_u64_be(ccursor_handle_t *handle, uint64_t *value);
+
+/**
+ * @brief Retrieves a raw little-endian 64-bit signed integer from the stream
+ *
+ * This function retrieves 8 raw bytes from the char cursor handle and
+ * interprets them as little-endian 64-bit signed integer. In contrast to the
+ * text based readers no characters are parsed. It advances the current position
+ * in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 64-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 8 bytes are available
+ */
+ccursor_ret_t ccursor_get_i64_le(ccursor_handle_t *handle, int64_t *value);
+
+/**
+ * @brief Retrieves a raw big-endian 64-bit signed integer from the stream
+ *
+ * This function retrieves 8 raw bytes from the char cursor handle and
+ * interprets them as big-endian 64-bit signed integer. In contrast to the text
+ * based readers no characters are parsed. It advances the current position in
+ * the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 64-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than 8 bytes are available
+ */
+ccursor_ret_t ccursor_get_i64_be(ccursor_handle_t *handle, int64_t *value);
+
+/**
+ * @brief Retrieves an array of raw little-endian 16-bit unsigned integers
+ *
+ * This function retrieves count consecutive little-endian 16-bit unsigned
+ * integers from the char cursor handle and converts them into host byte
+ * order. It advances the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    values        - The retrieved values, count elements
+ * @param[in]     count         - The number of values to retrieve
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than count values are available
+ */
+ccursor_ret_t ccursor_get_array_u16_le(ccursor_handle_t *handle,
+                                       uint16_t *values, size_t count);
+
+/**
+ * @brief Retrieves an array of raw big-endian 16-bit unsigned integers
+ *
+ * This function retrieves count consecutive big-endian 16-bit unsigned
+ * integers from the char cursor handle and converts them into host byte
+ * order. It advances the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    values        - The retrieved values, count elements
+ * @param[in]     count         - The number of values to retrieve
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than count values are available
+ */
+ccursor_ret_t ccursor_get_array_u16_be(ccursor_handle_t *handle,
+                                       uint16_t *values, size_t count);
+
+/**
+ * @brief Retrieves an array of raw little-endian 32-bit unsigned integers
+ *
+ * This function retrieves count consecutive little-endian 32-bit unsigned
+ * integers from the char cursor handle and converts them into host byte
+ * order. It advances the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    values        - The retrieved values, count elements
+ * @param[in]     count         - The number of values to retrieve
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than count values are available
+ */
+ccursor_ret_t ccursor_get_array_u32_le(ccursor_handle_t *handle,
+                                       uint32_t *values, size_t count);
+
+/**
+ * @brief Retrieves an array of raw big-endian 32-bit unsigned integers
+ *
+ * This function retrieves count consecutive big-endian 32-bit unsigned
+ * integers from the char cursor handle and converts them into host byte
+ * order. It advances the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    values        - The retrieved values, count elements
+ * @param[in]     count         - The number of values to retrieve
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than count values are available
+ */
+ccursor_ret_t ccursor_get_array_u32_be(ccursor_handle_t *handle,
+                                       uint32_t *values, size_t count);
+
+/**
+ * @brief Retrieves an array of raw little-endian 64-bit unsigned integers
+ *
+ * This function retrieves count consecutive little-endian 64-bit unsigned
+ * integers from the char cursor handle and converts them into host byte
+ * order. It advances the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    values        - The retrieved values, count elements
+ * @param[in]     count         - The number of values to retrieve
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than count values are available
+ */
+ccursor_ret_t ccursor_get_array_u64_le(ccursor_handle_t *handle,
+                                       uint64_t *values, size_t count);
+
+/**
+ * @brief Retrieves an array of raw big-endian 64-bit unsigned integers
+ *
+ * This function retrieves count consecutive big-endian 64-bit unsigned
+ * integers from the char cursor handle and converts them into host byte
+ * order. It advances the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    values        - The retrieved values, count elements
+ * @param[in]     count         - The number of values to retrieve
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than count values are available
+ */
+ccursor_ret_t ccursor_get_array_u64_be(ccursor_handle_t *handle,
+                                       uint64_t *values, size_t count);
+
+/**
+ * @brief Retrieves a LEB128 encoded 32-bit unsigned integer from the stream
+ *
+ * This function retrieves a varint as used by protobuf, 7 bits per byte with
+ * the least significant group first and the top bit marking continuation. It
+ * advances the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 32-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if the varint is truncated or exceeds 32 bits
+ */
+ccursor_ret_t ccursor_read_varint_u32(ccursor_handle_t *handle,
+                                      uint32_t *value);
+
+/**
+ * @brief Retrieves a LEB128 encoded 64-bit unsigned integer from the stream
+ *
+ * This function retrieves a varint, see ccursor_read_varint_u32. It advances
+ * the current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 64-bit unsigned integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if the varint is truncated or exceeds 64 bits
+ */
+ccursor_ret_t ccursor_read_varint_u64(ccursor_handle_t *handle,
+                                      uint64_t *value);
+
+/**
+ * @brief Retrieves a zigzag encoded 32-bit signed integer from the stream
+ *
+ * This function retrieves a varint and maps it back from the zigzag encoding
+ * (0, -1, 1, -2, ... encoded as 0, 1, 2, 3, ...). It advances the current
+ * position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 32-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if the varint is truncated or exceeds 32 bits
+ */
+ccursor_ret_t ccursor_read_varint_i32(ccursor_handle_t *handle,
+                                      int32_t *value);
+
+/**
+ * @brief Retrieves a zigzag encoded 64-bit signed integer from the stream
+ *
+ * This function retrieves a varint and maps it back from the zigzag
+ * encoding, see ccursor_read_varint_i32. It advances the current position in
+ * the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    value         - The retrieved 64-bit signed integer
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
+ * @return E_CCURSOR_ERR_PARSE if the varint is truncated or exceeds 64 bits
+ */
+ccursor_ret_t ccursor_read_varint_i64(ccursor_handle_t *handle,
+                                      int64_t *value);
+
+/**
+ * @brief Retrieves an array of LEB128 encoded 32-bit unsigned integers
+ *
+ * This function retrieves count consecutive varints from the char cursor
+ * handle. The continuation bits of 16 bytes are classified at once, which
+ * decodes runs of small values without per-byte branches. It advances the
+ * current position in the buffer accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[out]    values        - The retrieved values, count elements
+ * @param[in]     count         - The number of values to retrieve
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if less than count valid varints are available,
+ *         the position is not advanced in this case
+ */
+ccursor_ret_t ccursor_read_varints(ccursor_handle_t *handle, uint32_t *values,
+                                   size_t count);
+
 /**
  * @brief Retrieves a byte from the stream
  *
@@ -375,7 +1393,8 @@ ccursor_ret_t ccursor_read_i8_be(ccursor_handle_t *handle, int8_t *value);
  * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
  * @return E_CCURSOR_ERR_PARSE on error
  */
-ccursor_ret_t ccursor_read_byte(ccursor_handle_t *handle, uint8_t *byte);
+CCURSOR_HOT ccursor_ret_t ccursor_read_byte(ccursor_handle_t *handle,
+                                          uint8_t *byte);
 
 /**
  * @brief Retrieves a boolean value from the stream
@@ -403,7 +1422,7 @@ ccursor_ret_t ccursor_read_bool(ccursor_handle_t *handle, bool *value);
  * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
  * @return E_CCURSOR_ERR_PARSE on error
  */
-ccursor_ret_t ccursor_read_char(ccursor_handle_t *handle, char *c);
+CCURSOR_HOT ccursor_ret_t ccursor_read_char(ccursor_handle_t *handle, char *c);
 
 /**
  * @brief Skips a character in the stream
@@ -417,7 +1436,7 @@ ccursor_ret_t ccursor_read_char(ccursor_handle_t *handle, char *c);
  * @return E_CCURSOR_ERR_PARAM if the handle or value is NULL
  * @return E_CCURSOR_ERR_PARSE on error
  */
-ccursor_ret_t ccursor_skip_char(ccursor_handle_t *handle, char c);
+CCURSOR_HOT ccursor_ret_t ccursor_skip_char(ccursor_handle_t *handle, char c);
 
 /**
  * @brief Skips characters in the stream until a specified character is found
@@ -438,7 +1457,8 @@ ccursor_ret_t ccursor_skip_until_char(ccursor_handle_t *handle, uint8_t c);
  * @brief Skips substring at the beginning of the stream
  *
  * This function skips the requested substring at the beginning of the stream.
- * It advances the current position in the buffer accordingly.
+ * It only compares the substring in place and advances the current position
+ * in the buffer accordingly.
  *
  * @param[in,out] handle        - The char cursor handle
  * @param[in]     substr        - The substring to skip
@@ -452,8 +1472,8 @@ ccursor_ret_t ccursor_skip_substr(ccursor_handle_t *handle, const char *substr);
  * @brief Skips characters in the stream until a specified substring is found
  *
  * This function skips characters in the char cursor handle until the
- * specified substring is found. It advances the current position in the buffer
- * accordingly.
+ * specified substring is found, the search stops at the end of the buffer.
+ * It advances the current position in the buffer behind the substring.
  *
  * @param[in,out] handle        - The char cursor handle
  * @param[in]     substr        - The substring to stop skipping at
@@ -464,6 +1484,54 @@ ccursor_ret_t ccursor_skip_substr(ccursor_handle_t *handle, const char *substr);
 ccursor_ret_t ccursor_skip_until_substr(ccursor_handle_t *handle,
                                         const char *substr);
 
+/**
+ * @brief Skips characters until the last occurrence of a character
+ *
+ * This function searches the stream backwards from its end, such that the
+ * costs only depend on the distance of the character from the end, e.g. of
+ * the '*' in front of the checksum of an NMEA sentence. It advances the
+ * current position in the buffer behind the found character.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     c             - The character to search
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle is NULL or the stream is empty
+ * @return E_CCURSOR_ERR_PARSE if the character is not found
+ */
+ccursor_ret_t ccursor_rfind_char(ccursor_handle_t *handle, uint8_t c);
+
+/**
+ * @brief Skips characters until the last occurrence of a substring
+ *
+ * This function searches the stream backwards from its end and advances the
+ * current position in the buffer behind the found substring.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     substr        - The substring to search
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or substr is NULL or the stream
+ *         is empty
+ * @return E_CCURSOR_ERR_PARSE if the substring is not found
+ */
+ccursor_ret_t ccursor_rfind_substr(ccursor_handle_t *handle,
+                                   const char *substr);
+
+/**
+ * @brief Cuts the stream at the last occurrence of a character
+ *
+ * This function searches the stream backwards from its end and moves the end
+ * of the stream in front of the found character, e.g. to limit an NMEA
+ * sentence to the part covered by its checksum. The buffer itself is not
+ * modified.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     c             - The character to search
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle is NULL or the stream is empty
+ * @return E_CCURSOR_ERR_PARSE if the character is not found
+ */
+ccursor_ret_t ccursor_trim_right_at_char(ccursor_handle_t *handle, uint8_t c);
+
 /**
  * @brief Reads a substring from the stream
  *
@@ -516,4 +1584,53 @@ ccursor_ret_t ccursor_read_substr_until_char(ccursor_handle_t *handle,
  */
 ccursor_ret_t ccursor_trim_left(ccursor_handle_t *handle);
 
+/**
+ * @brief Trims leading characters of a whitespace class from the stream
+ *
+ * Unlike ccursor_trim_left, which only trims spaces, this function trims all
+ * members of the class. It advances the current position in the buffer
+ * accordingly.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     whitespace    - The whitespace class, or NULL for
+ *                                " \t\n\v\f\r"
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle is NULL or the stream is empty
+ */
+ccursor_ret_t ccursor_trim_left_ws(ccursor_handle_t *handle,
+                                   const ccursor_charset_t *whitespace);
+
+/**
+ * @brief Trims trailing characters of a whitespace class from the stream
+ *
+ * This function moves the end of the stream in front of the trailing
+ * whitespace, e.g. a line break or the padding of a fixed-width field, by
+ * shrinking the buffer size. The buffer itself is not modified.
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     whitespace    - The whitespace class, or NULL for
+ *                                " \t\n\v\f\r"
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle is NULL or the stream is empty
+ */
+ccursor_ret_t ccursor_trim_right(ccursor_handle_t *handle,
+                                 const ccursor_charset_t *whitespace);
+
+/**
+ * @brief Trims leading and trailing characters of a whitespace class from
+ *        the stream
+ *
+ * @param[in,out] handle        - The char cursor handle
+ * @param[in]     whitespace    - The whitespace class, or NULL for
+ *                                " \t\n\v\f\r"
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle is NULL or the stream is empty
+ */
+ccursor_ret_t ccursor_trim(ccursor_handle_t *handle,
+                           const ccursor_charset_t *whitespace);
+
+#if defined(CCURSOR_HEADER_ONLY)
+#include "ccursor_inline.h"
+#endif
+
 #endif // CCURSOR_HEADER
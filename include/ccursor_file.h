@@ -0,0 +1,76 @@
+#ifndef CCURSOR_FILE_HEADER
+#define CCURSOR_FILE_HEADER
+
+#include "ccursor.h"
+
+/*
+ * Memory mapped files with a persistent line index (POSIX only).
+ *
+ * The offset of every interval-th line is kept in a sidecar file next to the
+ * file, "<path>.ccidx". The sidecar is reused as long as the size and
+ * modification time of the file match, otherwise it is rebuilt.
+ */
+
+// lines between two sampled offsets if no interval is given
+#define CCURSOR_FILE_DEFAULT_INTERVAL 4096
+
+/**
+ * @brief Memory mapped file with its sampled line index
+ */
+typedef struct {
+  char *data;            /**< Mapped contents of the file */
+  size_t size;           /**< Size of the file in bytes */
+  uint64_t lines;        /**< Number of lines, see ccursor_count_lines */
+  uint32_t interval;     /**< Lines between two sampled offsets */
+  uint64_t *samples;     /**< Offset of every interval-th line */
+  size_t sample_count;   /**< Number of sampled offsets */
+} ccursor_file_t;
+
+/**
+ * @brief Maps a file and loads or builds its line index
+ *
+ * This function maps the file read-only and loads the line index from its
+ * sidecar file. A missing or stale sidecar is rebuilt with the given
+ * interval and written back, a sidecar which cannot be written is not an
+ * error.
+ *
+ * @param[out]    file          - The mapped file
+ * @param[in]     path          - The path of the file
+ * @param[in]     interval      - Lines between two sampled offsets, 0 for
+ *                                CCURSOR_FILE_DEFAULT_INTERVAL
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the file or path is NULL
+ * @return E_CCURSOR_ERR if the file cannot be opened, is empty or cannot be
+ *         mapped
+ */
+ccursor_ret_t ccursor_file_open(ccursor_file_t *file, const char *path,
+                                uint32_t interval);
+
+/**
+ * @brief Retrieves a range of lines of a mapped file
+ *
+ * This function seeks to the sampled offset in front of the first line and
+ * skips the remaining lines, such that the costs do not depend on the
+ * position of the range within the file. The lines can be iterated with
+ * ccursor_next_line afterwards.
+ *
+ * @param[in]     file          - The mapped file
+ * @param[in]     first         - The first line, starting at 0
+ * @param[in]     count         - The number of lines, fewer at the file end
+ * @param[out]    lines         - The handle of the lines
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the file or lines is NULL or count is zero
+ * @return E_CCURSOR_ERR_PARSE if the first line does not exist or the range
+ *         exceeds the size of a handle
+ */
+ccursor_ret_t ccursor_file_lines(const ccursor_file_t *file, uint64_t first,
+                                 uint64_t count, ccursor_handle_t *lines);
+
+/**
+ * @brief Unmaps a file and releases its line index
+ *
+ * @param[in,out] file          - The mapped file
+ */
+void ccursor_file_close(ccursor_file_t *file);
+
+#endif // CCURSOR_FILE_HEADER
@@ -0,0 +1,78 @@
+#ifndef CCURSOR_FOLLOW_HEADER
+#define CCURSOR_FOLLOW_HEADER
+
+#include "ccursor.h"
+
+/*
+ * Following a growing file, like "tail -F" (Linux only).
+ *
+ * Appended bytes are read as they arrive, inotify wakes up the reader
+ * instead of polling. Only complete lines are handed out, an incomplete last
+ * line is kept until its '\n' arrives. A truncated file is read again from
+ * the start, a rotated file is read up to its end before the new file at the
+ * same path is followed.
+ */
+
+// bytes read from the file at once
+#define CCURSOR_FOLLOW_CHUNK (64 * 1024)
+
+/**
+ * @brief State of a followed file
+ */
+typedef struct {
+  char *path;        /**< Copy of the path of the followed file */
+  int fd;            /**< Descriptor of the currently read file */
+  int notify;        /**< inotify instance waking up the reader */
+  int file_watch;    /**< Watch of the currently read file */
+  int dir_watch;     /**< Watch of the directory for a rotated file */
+  uint64_t offset;   /**< Offset of the next byte to read from the file */
+  bool discard;      /**< Drop the bytes up to the next '\n' */
+  char *buffer;      /**< Read bytes which are not yet released */
+  size_t pending;    /**< Number of bytes in the buffer */
+  size_t consumed;   /**< Bytes handed out by the last call */
+  size_t capacity;   /**< Capacity of the buffer */
+} ccursor_follow_t;
+
+/**
+ * @brief Starts following a file
+ *
+ * @param[out]    follow        - The follow state
+ * @param[in]     path          - The path of the file, which has to exist
+ * @param[in]     from_end      - Skip the current contents of the file,
+ *                                including an incomplete last line
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the follow state or path is NULL
+ * @return E_CCURSOR_ERR if the file cannot be opened or watched
+ */
+ccursor_ret_t ccursor_follow_open(ccursor_follow_t *follow, const char *path,
+                                  bool from_end);
+
+/**
+ * @brief Waits for the next complete lines of a followed file
+ *
+ * This function returns all complete lines which arrived since the last
+ * call, including their '\n'. The lines can be iterated with
+ * ccursor_next_line and stay valid until the next call. The incomplete last
+ * line of a rotated file is returned as well, once the new file shows up.
+ *
+ * @param[in,out] follow        - The follow state
+ * @param[in]     timeout       - Milliseconds to wait for new lines, 0 to
+ *                                return at once, -1 to wait forever
+ * @param[out]    lines         - The handle of the lines
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the follow state or lines is NULL
+ * @return E_CCURSOR_ERR_PARSE if no complete line arrived within the timeout
+ * @return E_CCURSOR_ERR if the file cannot be read or a line exceeds the size
+ *         of a handle
+ */
+ccursor_ret_t ccursor_follow_next(ccursor_follow_t *follow, int timeout,
+                                  ccursor_handle_t *lines);
+
+/**
+ * @brief Stops following a file and releases its resources
+ *
+ * @param[in,out] follow        - The follow state
+ */
+void ccursor_follow_close(ccursor_follow_t *follow);
+
+#endif // CCURSOR_FOLLOW_HEADER
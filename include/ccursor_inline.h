@@ -0,0 +1,62 @@
+#ifndef CCURSOR_INLINE_HEADER
+#define CCURSOR_INLINE_HEADER
+
+#include "ccursor.h"
+
+/*
+ * Hot primitives of the char cursor, declared with CCURSOR_HOT in ccursor.h.
+ *
+ * The library includes this header once to provide the out-of-line
+ * definitions. With CCURSOR_HEADER_ONLY defined, ccursor.h includes it into
+ * every translation unit of the caller as static inline functions instead.
+ */
+
+CCURSOR_HOT size_t ccursor_available(ccursor_handle_t *handle) {
+  if (handle == NULL) {
+    return 0;
+  }
+
+  return (size_t)(handle->buffer + handle->buffer_size - handle->read_position);
+}
+
+CCURSOR_HOT ccursor_ret_t ccursor_is_empty(ccursor_handle_t *handle) {
+  if (handle == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  if (handle->read_position >= handle->buffer + handle->buffer_size) {
+    return E_CCURSOR_OK;
+  }
+
+  return E_CCURSOR_ERR;
+}
+
+CCURSOR_HOT ccursor_ret_t ccursor_read_char(ccursor_handle_t *handle, char *c) {
+  if (handle == NULL ||
+      handle->read_position >= handle->buffer + handle->buffer_size) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  *c = *handle->read_position;
+  handle->read_position++;
+  return E_CCURSOR_OK;
+}
+
+CCURSOR_HOT ccursor_ret_t ccursor_read_byte(ccursor_handle_t *handle,
+                                          uint8_t *byte) {
+  return ccursor_read_char(handle, (char *)byte);
+}
+
+CCURSOR_HOT ccursor_ret_t ccursor_skip_char(ccursor_handle_t *handle, char c) {
+  if (handle == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  if (handle->read_position >= handle->buffer + handle->buffer_size ||
+      *handle->read_position != c) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  handle->read_position++;
+  return E_CCURSOR_OK;
+}
+
+#endif // CCURSOR_INLINE_HEADER
@@ -0,0 +1,166 @@
+#ifndef CCURSOR_IOVEC_HEADER
+#define CCURSOR_IOVEC_HEADER
+
+#include <sys/uio.h>
+
+#include "ccursor.h"
+
+/*
+ * Char cursor over scatter-gather segments (POSIX only).
+ *
+ * The segments of an iovec array are read in place, without coalescing them
+ * into one buffer. Only a token which straddles the boundary between two
+ * segments is copied into a small carry buffer and parsed from there.
+ */
+
+// longest token which can straddle a segment boundary
+#define CCURSOR_IOVEC_CARRY 64
+
+// largest value of a reader passed to ccursor_iovec_read
+#define CCURSOR_IOVEC_VALUE 64
+
+/**
+ * @brief Reader of a single token, e.g. a wrapper of ccursor_read_u32
+ *
+ * @param[in,out] handle - char cursor handle over the token
+ * @param[out]    value  - parsed value
+ * @return E_CCURSOR_RET_OK on success, else an error code
+ */
+typedef ccursor_ret_t (*ccursor_iovec_reader_t)(ccursor_handle_t *handle,
+                                                void *value);
+
+/**
+ * @brief Char cursor over an array of segments
+ */
+typedef struct {
+  const struct iovec *segments; /**< Segments to read */
+  size_t count;                 /**< Number of segments */
+  size_t index;                 /**< Index of the current segment */
+  ccursor_handle_t segment;     /**< Handle over the current segment */
+  char carry[2 * CCURSOR_IOVEC_CARRY + 1]; /**< Copy of a straddling token
+                                                and its lookahead */
+} ccursor_iovec_t;
+
+/**
+ * @brief Initializes the cursor with an array of segments
+ *
+ * The segments are not copied, they have to stay valid while the cursor is
+ * used. Empty segments are allowed, the segments do not need to be
+ * null-terminated.
+ *
+ * @param[out]    cursor        - The iovec cursor
+ * @param[in]     segments      - The segments to read
+ * @param[in]     count         - The number of segments
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the cursor or segments is NULL or a segment
+ *         exceeds the size of a handle
+ */
+ccursor_ret_t ccursor_iovec_init(ccursor_iovec_t *cursor,
+                                 const struct iovec *segments, size_t count);
+
+/**
+ * @brief Retrieves the number of characters left in all segments
+ *
+ * @param[in]     cursor        - The iovec cursor
+ * @return The number of available characters
+ */
+size_t ccursor_iovec_available(const ccursor_iovec_t *cursor);
+
+/**
+ * @brief Retrieves the number of characters consumed since the cursor was
+ *        initialized
+ *
+ * @param[in]     cursor        - The iovec cursor
+ * @return The number of consumed characters
+ */
+size_t ccursor_iovec_position(const ccursor_iovec_t *cursor);
+
+/**
+ * @brief Parses a token with any reader of this library
+ *
+ * This function runs the reader in place on the current segment. Only if the
+ * token may continue in the next segment, i.e. the reader failed or stopped
+ * less than CCURSOR_IOVEC_CARRY characters before the end of the segment, it
+ * is parsed once more from the carry buffer holding the token and the start
+ * of the following segments. The reader fills a copy of the value, which is
+ * only stored on success. It advances the cursor behind the token.
+ *
+ * @param[in,out] cursor        - The iovec cursor
+ * @param[in]     reader        - The reader of the token
+ * @param[out]    value         - The value passed on to the reader
+ * @param[in]     size          - The size of the value, at most
+ *                                CCURSOR_IOVEC_VALUE
+ * @return The return code of the reader
+ * @return E_CCURSOR_ERR_PARAM if the cursor, reader or value is NULL, the
+ *         size is out of range or all segments are consumed
+ * @return E_CCURSOR_ERR_PARSE if a token near a segment boundary is longer
+ *         than CCURSOR_IOVEC_CARRY
+ */
+ccursor_ret_t ccursor_iovec_read(ccursor_iovec_t *cursor,
+                                 ccursor_iovec_reader_t reader, void *value,
+                                 size_t size);
+
+/**
+ * @brief Retrieves numbers, see ccursor_read_u32, ccursor_read_i32 and
+ *        ccursor_read_f64
+ *
+ * @param[in,out] cursor        - The iovec cursor
+ * @param[out]    value         - The retrieved number
+ * @return see ccursor_iovec_read
+ */
+ccursor_ret_t ccursor_iovec_read_u32(ccursor_iovec_t *cursor, uint32_t *value);
+ccursor_ret_t ccursor_iovec_read_i32(ccursor_iovec_t *cursor, int32_t *value);
+ccursor_ret_t ccursor_iovec_read_f64(ccursor_iovec_t *cursor, double *value);
+
+/**
+ * @brief Retrieves a single character, see ccursor_read_char
+ *
+ * @param[in,out] cursor        - The iovec cursor
+ * @param[out]    c             - The retrieved character
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the cursor or c is NULL or all segments are
+ *         consumed
+ */
+ccursor_ret_t ccursor_iovec_read_char(ccursor_iovec_t *cursor, char *c);
+
+/**
+ * @brief Skips a character if it matches, see ccursor_skip_char
+ *
+ * @param[in,out] cursor        - The iovec cursor
+ * @param[in]     c             - The character to skip
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the cursor is NULL or all segments are
+ *         consumed
+ * @return E_CCURSOR_ERR_PARSE if the character does not match
+ */
+ccursor_ret_t ccursor_iovec_skip_char(ccursor_iovec_t *cursor, char c);
+
+/**
+ * @brief Skips a substring if it follows, even across segment boundaries
+ *
+ * @param[in,out] cursor        - The iovec cursor
+ * @param[in]     substr        - The substring to skip
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the cursor or substr is NULL or all
+ *         segments are consumed
+ * @return E_CCURSOR_ERR_PARSE if the substring does not follow
+ */
+ccursor_ret_t ccursor_iovec_skip_substr(ccursor_iovec_t *cursor,
+                                        const char *substr);
+
+/**
+ * @brief Skips all characters up to and including a character, see
+ *        ccursor_skip_until_char
+ *
+ * @param[in,out] cursor        - The iovec cursor
+ * @param[in]     c             - The character to search for
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the cursor is NULL or all segments are
+ *         consumed
+ * @return E_CCURSOR_ERR_PARSE if the character is not found, the cursor is
+ *         left unchanged
+ */
+ccursor_ret_t ccursor_iovec_skip_until_char(ccursor_iovec_t *cursor,
+                                            uint8_t c);
+
+#endif // CCURSOR_IOVEC_HEADER
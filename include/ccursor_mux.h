@@ -0,0 +1,147 @@
+#ifndef CCURSOR_MUX_HEADER
+#define CCURSOR_MUX_HEADER
+
+#include "ccursor.h"
+
+/*
+ * Multiplexer of AT modems (Linux only).
+ *
+ * A single thread waits with epoll for the tty descriptors of many modems
+ * and splits their output into frames. The response to a command is one
+ * frame up to its final result code, e.g. "OK" or "+CME ERROR: 10", all
+ * other lines are unsolicited result codes (URCs) of their own. The frames
+ * are handed to a callback on a small pool of worker threads, the frames of
+ * one modem always go to the same worker and keep their order.
+ */
+
+// capacity of the receive buffer of a modem, a longer line is dropped up to
+// its line break
+#define CCURSOR_MUX_BUFFER_SIZE 4096
+
+/**
+ * @brief Kinds of frames
+ */
+typedef enum {
+  E_CCURSOR_FRAME_URC = 0,    /**< Unsolicited result code, a single line */
+  E_CCURSOR_FRAME_OK = 1,     /**< Response finished with "OK" */
+  E_CCURSOR_FRAME_ERROR = 2,  /**< Response finished with an error code or
+                                   with lines lost on the way */
+  E_CCURSOR_FRAME_HANGUP = 3, /**< Modem hung up and was removed, no lines */
+} ccursor_frame_type_t;
+
+/**
+ * @brief Frame of a modem passed to the callback
+ */
+typedef struct {
+  int fd;                    /**< Descriptor of the modem */
+  void *context;             /**< Context of the modem, see ccursor_mux_add */
+  ccursor_frame_type_t type; /**< Kind of the frame */
+  ccursor_handle_t lines;    /**< Lines of the frame including the final
+                                  result code, '\n' terminated */
+} ccursor_frame_t;
+
+/**
+ * @brief Callback receiving the frames, the lines are only valid during the
+ *        call
+ */
+typedef void (*ccursor_frame_cb_t)(const ccursor_frame_t *frame);
+
+/**
+ * @brief Configuration of a multiplexer
+ */
+typedef struct {
+  ccursor_frame_cb_t callback; /**< Receiver of the frames */
+  size_t workers;              /**< Worker threads, 0 to call the callback
+                                    from ccursor_mux_poll */
+  const char *const *urcs;     /**< NULL terminated prefixes of lines which
+                                    are URCs even within a response, or
+                                    NULL */
+} ccursor_mux_config_t;
+
+/**
+ * @brief Opaque multiplexer
+ */
+typedef struct ccursor_mux ccursor_mux_t;
+
+/**
+ * @brief Creates a multiplexer and starts its workers
+ *
+ * @param[out]    mux           - The created multiplexer
+ * @param[in]     config        - The configuration, it is copied
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if mux, config or the callback is NULL or the
+ *         URC prefixes are empty, duplicated or too many, see
+ *         ccursor_prefix_init
+ * @return E_CCURSOR_ERR if the resources cannot be allocated
+ */
+ccursor_ret_t ccursor_mux_create(ccursor_mux_t **mux,
+                                 const ccursor_mux_config_t *config);
+
+/**
+ * @brief Adds a modem to the multiplexer
+ *
+ * The descriptor is switched to non-blocking mode and stays owned by the
+ * caller, it has to be removed before it is closed.
+ *
+ * @param[in,out] mux           - The multiplexer
+ * @param[in]     fd            - The descriptor of the modem
+ * @param[in]     context       - The context passed on with its frames
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if mux is NULL, fd is negative or already
+ *         added
+ * @return E_CCURSOR_ERR if the descriptor cannot be watched
+ */
+ccursor_ret_t ccursor_mux_add(ccursor_mux_t *mux, int fd, void *context);
+
+/**
+ * @brief Removes a modem from the multiplexer
+ *
+ * @param[in,out] mux           - The multiplexer
+ * @param[in]     fd            - The descriptor of the modem
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if mux is NULL or fd is not added
+ */
+ccursor_ret_t ccursor_mux_remove(ccursor_mux_t *mux, int fd);
+
+/**
+ * @brief Sends a command to a modem
+ *
+ * The lines following the command are collected into a single response
+ * frame up to the final result code. This function may be called from the
+ * callback.
+ *
+ * @param[in,out] mux           - The multiplexer
+ * @param[in]     fd            - The descriptor of the modem
+ * @param[in]     command       - The command including its terminating '\r'
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if mux or command is NULL or fd is not added
+ * @return E_CCURSOR_ERR if the command cannot be written at once
+ */
+ccursor_ret_t ccursor_mux_send(ccursor_mux_t *mux, int fd,
+                               const char *command);
+
+/**
+ * @brief Waits for the modems and frames their output
+ *
+ * This function runs a single round of the event loop and is meant to be
+ * called repeatedly from one thread.
+ *
+ * @param[in,out] mux           - The multiplexer
+ * @param[in]     timeout       - Milliseconds to wait, -1 to wait forever
+ * @param[out]    frames        - The number of dispatched frames, or NULL
+ * @return E_CCURSOR_RET_OK on success, also on timeout
+ * @return E_CCURSOR_ERR_PARAM if mux is NULL
+ * @return E_CCURSOR_ERR if waiting failed
+ */
+ccursor_ret_t ccursor_mux_poll(ccursor_mux_t *mux, int timeout,
+                               size_t *frames);
+
+/**
+ * @brief Stops the workers after their queued frames and destroys the
+ *        multiplexer
+ *
+ * @param[in]     mux           - The multiplexer
+ */
+void ccursor_mux_destroy(ccursor_mux_t *mux);
+
+#endif // CCURSOR_MUX_HEADER
@@ -0,0 +1,131 @@
+#ifndef CCURSOR_RING_HEADER
+#define CCURSOR_RING_HEADER
+
+#include <stdatomic.h>
+
+#include "ccursor_iovec.h"
+
+/*
+ * Lock-free ring buffer of a single producer and a single consumer.
+ *
+ * The producer, e.g. a UART reader thread, writes into the free part of the
+ * ring and publishes the written bytes. The consumer parses the published
+ * bytes in place with an iovec cursor, which covers the wraparound with two
+ * segments, and releases the parsed bytes. The indices are exchanged with
+ * acquire/release atomics only, neither side takes a lock or copies data.
+ */
+
+// size of a cache line, separates the indices of producer and consumer
+#define CCURSOR_RING_CACHE_LINE 64
+
+/**
+ * @brief Ring buffer shared by one producer and one consumer
+ *
+ * The indices count all bytes ever written and released, they wrap around
+ * naturally and are reduced to offsets with the mask.
+ */
+typedef struct {
+  char *buffer; /**< Storage of the ring */
+  size_t mask;  /**< Capacity of the ring minus one */
+
+  _Alignas(CCURSOR_RING_CACHE_LINE) atomic_size_t head; /**< Written bytes */
+  size_t tail_cache; /**< Producer copy of the tail */
+
+  _Alignas(CCURSOR_RING_CACHE_LINE) atomic_size_t tail; /**< Released bytes */
+} ccursor_ring_t;
+
+/**
+ * @brief Published bytes of a ring, read with an iovec cursor
+ */
+typedef struct {
+  struct iovec segments[2]; /**< Published bytes in front of and behind the
+                                 wraparound */
+  ccursor_iovec_t cursor;   /**< Cursor over the segments */
+} ccursor_ring_view_t;
+
+/**
+ * @brief Initializes a ring buffer
+ *
+ * @param[out]    ring          - The ring buffer
+ * @param[in]     buffer        - The storage of the ring
+ * @param[in]     capacity      - The size of the storage, a power of two
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the ring or buffer is NULL or the capacity
+ *         is not a power of two
+ */
+ccursor_ret_t ccursor_ring_init(ccursor_ring_t *ring, char *buffer,
+                                size_t capacity);
+
+/**
+ * @brief Retrieves the free part of the ring (producer)
+ *
+ * The producer writes directly into the returned segments, e.g. with readv,
+ * and publishes the written bytes with ccursor_ring_commit.
+ *
+ * @param[in,out] ring          - The ring buffer
+ * @param[out]    segments      - The free bytes in front of and behind the
+ *                                wraparound, the second one may be empty
+ * @param[out]    available     - The number of free bytes, or NULL
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the ring or segments is NULL
+ */
+ccursor_ret_t ccursor_ring_reserve(ccursor_ring_t *ring,
+                                   struct iovec segments[2],
+                                   size_t *available);
+
+/**
+ * @brief Publishes written bytes to the consumer (producer)
+ *
+ * @param[in,out] ring          - The ring buffer
+ * @param[in]     size          - The number of written bytes, at most the
+ *                                free ones
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the ring is NULL or the size exceeds the
+ *         free bytes
+ */
+ccursor_ret_t ccursor_ring_commit(ccursor_ring_t *ring, size_t size);
+
+/**
+ * @brief Copies bytes into the ring and publishes them (producer)
+ *
+ * @param[in,out] ring          - The ring buffer
+ * @param[in]     data          - The bytes to write
+ * @param[in]     size          - The number of bytes to write
+ * @param[out]    written       - The number of written bytes, fewer if the
+ *                                ring is full
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the ring, data or written is NULL
+ */
+ccursor_ret_t ccursor_ring_write(ccursor_ring_t *ring, const char *data,
+                                 size_t size, size_t *written);
+
+/**
+ * @brief Retrieves the published bytes of the ring (consumer)
+ *
+ * The bytes stay in the ring until they are released. Tokens at the end of
+ * the view may be incomplete, so only complete records should be parsed,
+ * e.g. up to the last '\n'.
+ *
+ * @param[in,out] ring          - The ring buffer
+ * @param[out]    view          - The cursor over the published bytes, it
+ *                                must not be copied
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the ring or view is NULL
+ * @return E_CCURSOR_ERR_PARSE if the ring is empty
+ */
+ccursor_ret_t ccursor_ring_peek(ccursor_ring_t *ring,
+                                ccursor_ring_view_t *view);
+
+/**
+ * @brief Hands parsed bytes back to the producer (consumer)
+ *
+ * @param[in,out] ring          - The ring buffer
+ * @param[in]     size          - The number of parsed bytes, at most the
+ *                                published ones, see ccursor_iovec_position
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the ring is NULL or the size exceeds the
+ *         published bytes
+ */
+ccursor_ret_t ccursor_ring_release(ccursor_ring_t *ring, size_t size);
+
+#endif // CCURSOR_RING_HEADER
@@ -0,0 +1,137 @@
+#ifndef CCURSOR_UNCHECKED_HEADER
+#define CCURSOR_UNCHECKED_HEADER
+
+#include "ccursor.h"
+
+/*
+ * Unchecked primitives for fixed-layout records of trusted input.
+ *
+ * ccursor_reserve checks once that a record of known size is available and
+ * hands out a window over it. The primitives below work within that window
+ * without any NULL or bounds checks, the caller has to stay within the
+ * reserved size. Digit and character classes are not validated either.
+ */
+
+/**
+ * @brief Reads a character of the window
+ *
+ * @param[in,out] window - The reserved window
+ * @return The character
+ */
+static inline char ccursor_read_char_unchecked(ccursor_unchecked_t *window) {
+  return *window->read_position++;
+}
+
+/**
+ * @brief Reads a byte of the window
+ *
+ * @param[in,out] window - The reserved window
+ * @return The byte
+ */
+static inline uint8_t ccursor_read_byte_unchecked(ccursor_unchecked_t *window) {
+  return (uint8_t)*window->read_position++;
+}
+
+/**
+ * @brief Skips a number of characters of the window
+ *
+ * @param[in,out] window - The reserved window
+ * @param[in]     size   - Number of characters to skip
+ */
+static inline void ccursor_skip_unchecked(ccursor_unchecked_t *window,
+                                          size_t size) {
+  window->read_position += size;
+}
+
+/**
+ * @brief Skips a character of the window if it matches
+ *
+ * @param[in,out] window - The reserved window
+ * @param[in]     c      - The character to skip
+ * @return true if the character matched and was skipped, else false
+ */
+static inline bool ccursor_skip_char_unchecked(ccursor_unchecked_t *window,
+                                               char c) {
+  if (*window->read_position != c) {
+    return false;
+  }
+
+  window->read_position++;
+  return true;
+}
+
+/**
+ * @brief Reads a fixed number of decimal digits of the window
+ *
+ * Suited for fixed-width fields like "20240131", the digits are not
+ * validated and there is neither a sign nor leading whitespace.
+ *
+ * @param[in,out] window - The reserved window
+ * @param[in]     digits - Number of digits, at most 9
+ * @return The decimal value of the digits
+ */
+static inline uint32_t ccursor_read_digits_unchecked(
+    ccursor_unchecked_t *window, uint8_t digits) {
+  uint32_t num = 0;
+  for (uint8_t idx = 0; idx < digits; idx++) {
+    num = num * 10 + (uint32_t)(window->read_position[idx] - '0');
+  }
+
+  window->read_position += digits;
+  return num;
+}
+
+/**
+ * @brief Reads binary integers in the named byte order of the window
+ *
+ * The bytes are combined explicitly, which compilers turn into a single load
+ * plus byte swap where needed.
+ *
+ * @param[in,out] window - The reserved window
+ * @return The integer in host byte order
+ */
+static inline uint16_t ccursor_get_u16_le_unchecked(
+    ccursor_unchecked_t *window) {
+  const uint8_t *p = (const uint8_t *)window->read_position;
+  window->read_position += 2;
+  return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static inline uint16_t ccursor_get_u16_be_unchecked(
+    ccursor_unchecked_t *window) {
+  const uint8_t *p = (const uint8_t *)window->read_position;
+  window->read_position += 2;
+  return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+static inline uint32_t ccursor_get_u32_le_unchecked(
+    ccursor_unchecked_t *window) {
+  const uint8_t *p = (const uint8_t *)window->read_position;
+  window->read_position += 4;
+  return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+         (uint32_t)p[3] << 24;
+}
+
+static inline uint32_t ccursor_get_u32_be_unchecked(
+    ccursor_unchecked_t *window) {
+  const uint8_t *p = (const uint8_t *)window->read_position;
+  window->read_position += 4;
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 |
+         (uint32_t)p[3];
+}
+
+static inline uint64_t ccursor_get_u64_le_unchecked(
+    ccursor_unchecked_t *window) {
+  uint64_t low = ccursor_get_u32_le_unchecked(window);
+  uint64_t high = ccursor_get_u32_le_unchecked(window);
+  return high << 32 | low;
+}
+
+static inline uint64_t ccursor_get_u64_be_unchecked(
+    ccursor_unchecked_t *window) {
+  uint64_t high = ccursor_get_u32_be_unchecked(window);
+  uint64_t low = ccursor_get_u32_be_unchecked(window);
+  return high << 32 | low;
+}
+
+#endif // CCURSOR_UNCHECKED_HEADER
@@ -1,54 +1,22 @@
 
-#include "ccursor.h"
-#include "ccursor_port.h"
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
 
-#define CCURSOR_END(handle) (handle->buffer + handle->buffer_size)
-#define CCURSOR_REMAINING_SIZE(handle)                                         \
-  (CCURSOR_END(handle) - handle->read_position)
-/**
- * @brief Convert char HEX character into a nibble
- *
- * @param[out] nibble - parsed nibble value
- * @param[in]  c      - character to parse
- * @return true on success, else false
- */
-static bool ccursor_hex_char_to_nibble(uint8_t *nibble, const char c) {
-  if (c >= '0' && c <= '9') {
-    *nibble = (c - '0');
-    return true;
-  } else if (c >= 'a' && c <= 'f') {
-    *nibble = (c - 'a' + 10);
-    return true;
-  } else if (c >= 'A' && c <= 'F') {
-    *nibble = (c - 'A' + 10);
-    return true;
-  } else {
-    return false;
-  }
-}
-
-/**
- * @brief Inline swaps the byte order of a given value
- *
- * @param[in,out] value - value to swap bytes
- * @param[in]     size  - size of value
- */
-static void ccursor_byte_swap(uint8_t *value, size_t size) {
-  for (size_t i = 0; i < size / 2; i++) {
-    uint8_t temp = value[i];
-    value[i] = value[size - i - 1];
-    value[size - i - 1] = temp;
-  }
-}
+// out-of-line definitions of the hot primitives
+#include "ccursor_inline.h"
 
 ccursor_ret_t ccursor_init(ccursor_handle_t *handle, char *buffer,
                            uint32_t buffer_size) {
-  if (handle == NULL || buffer == NULL || buffer_size == 0) {
+  if (handle == NULL) {
     return E_CCURSOR_ERR_PARAM;
   }
 
   memset(handle, 0, sizeof(ccursor_handle_t));
 
+  if (buffer == NULL || buffer_size == 0) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
   char *termination = buffer + buffer_size;
   if (*termination != '\0') {
     return E_CCURSOR_ERR_NOT_TERMINATED;
@@ -61,255 +29,273 @@ ccursor_ret_t ccursor_init(ccursor_handle_t *handle, char *buffer,
   return E_CCURSOR_OK;
 }
 
-size_t ccursor_available(ccursor_handle_t *handle) {
-  if (handle == NULL) {
-    return 0;
+ccursor_ret_t ccursor_reserve(ccursor_handle_t *handle, size_t size,
+                              ccursor_unchecked_t *window) {
+  if (handle == NULL || window == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  if (handle->read_position > CCURSOR_END(handle) ||
+      size > (size_t)CCURSOR_REMAINING_SIZE(handle)) {
+    return E_CCURSOR_ERR_PARSE;
   }
 
-  return CCURSOR_REMAINING_SIZE(handle);
+  window->read_position = handle->read_position;
+  window->end = handle->read_position + size;
+  handle->read_position = window->end;
+  return E_CCURSOR_OK;
 }
 
-ccursor_ret_t ccursor_is_empty(ccursor_handle_t *handle) {
-  if (handle == NULL) {
+/**
+ * @brief Reads an unsigned decimal integer of at most max
+ *
+ * @param[in,out] handle - The char cursor handle
+ * @param[in]     max    - largest valid value
+ * @param[out]    value  - parsed value
+ * @return see ccursor_read_u32
+ */
+static ccursor_ret_t ccursor_read_unsigned(ccursor_handle_t *handle,
+                                           uint32_t max, uint32_t *value) {
+  if (handle == NULL || handle->read_position >= CCURSOR_END(handle)) {
     return E_CCURSOR_ERR_PARAM;
   }
-  if (handle->read_position >= CCURSOR_END(handle)) {
-    return E_CCURSOR_OK;
+
+  bool negative = false;
+  uint64_t num = 0;
+  const char *endptr = ccursor_parse_integer(
+      handle->read_position, CCURSOR_END(handle), &negative, &num);
+
+  // Check for various possible errors
+  if (endptr == NULL || num > max || (negative && num != 0)) {
+    return E_CCURSOR_ERR_PARSE;
   }
 
-  return E_CCURSOR_ERR;
+  *value = (uint32_t)num;
+  handle->read_position = (char *)endptr;
+
+  return E_CCURSOR_OK;
 }
 
-ccursor_ret_t ccursor_read_u32(ccursor_handle_t *handle, uint32_t *value) {
-  if (handle == NULL || value == NULL ||
-      handle->read_position >= CCURSOR_END(handle)) {
+/**
+ * @brief Reads a signed decimal integer within [-max - 1, max]
+ *
+ * @param[in,out] handle - The char cursor handle
+ * @param[in]     max    - largest valid value
+ * @param[out]    value  - parsed value
+ * @return see ccursor_read_i32
+ */
+static ccursor_ret_t ccursor_read_signed(ccursor_handle_t *handle,
+                                         int32_t max, int32_t *value) {
+  if (handle == NULL || handle->read_position >= CCURSOR_END(handle)) {
     return E_CCURSOR_ERR_PARAM;
   }
 
-  char *endptr = NULL;
-  unsigned long num = _strtoul(handle->read_position, &endptr, 10);
+  bool negative = false;
+  uint64_t num = 0;
+  const char *endptr = ccursor_parse_integer(
+      handle->read_position, CCURSOR_END(handle), &negative, &num);
 
   // Check for various possible errors
-  if (endptr == handle->read_position || num > _UINT32_MAX) {
+  const uint64_t limit = negative ? (uint64_t)max + 1 : (uint64_t)max;
+  if (endptr == NULL || num > limit) {
     return E_CCURSOR_ERR_PARSE;
   }
 
-  // Check if endptr is outside of the buffer
-  if (endptr > CCURSOR_END(handle)) {
+  *value = negative ? (int32_t)(0 - num) : (int32_t)num;
+  handle->read_position = (char *)endptr;
+
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Reads a hex integer of at most max, signed readers reinterpret the
+ *        bits of the value
+ *
+ * @param[in,out] handle - The char cursor handle
+ * @param[in]     max    - largest valid value
+ * @param[out]    value  - parsed value
+ * @return see ccursor_read_u32_be
+ */
+static ccursor_ret_t ccursor_read_hex(ccursor_handle_t *handle, uint32_t max,
+                                      uint32_t *value) {
+  if (handle == NULL || handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  uint32_t num = 0;
+  const char *endptr =
+      ccursor_parse_hex(handle->read_position, CCURSOR_END(handle), &num);
+  if (endptr == NULL || num > max) {
     return E_CCURSOR_ERR_PARSE;
   }
 
-  *value = (uint32_t)num;
-  handle->read_position = endptr;
+  *value = num;
+  handle->read_position = (char *)endptr;
 
   return E_CCURSOR_OK;
 }
 
+ccursor_ret_t ccursor_read_u32(ccursor_handle_t *handle, uint32_t *value) {
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  return ccursor_read_unsigned(handle, _UINT32_MAX, value);
+}
+
 ccursor_ret_t ccursor_read_u16(ccursor_handle_t *handle, uint16_t *value) {
-  uint32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_u32(handle, &num);
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_unsigned(handle, _UINT16_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num <= _UINT16_MAX) {
-      *value = (uint16_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (uint16_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
 ccursor_ret_t ccursor_read_u8(ccursor_handle_t *handle, uint8_t *value) {
-  uint32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_u32(handle, &num);
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_unsigned(handle, _UINT8_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num <= _UINT8_MAX) {
-      *value = (uint8_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (uint8_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
 ccursor_ret_t ccursor_read_i32(ccursor_handle_t *handle, int32_t *value) {
-  if (handle == NULL || value == NULL ||
-      handle->read_position >= CCURSOR_END(handle)) {
+  if (value == NULL) {
     return E_CCURSOR_ERR_PARAM;
   }
-
-  char *endptr = NULL;
-  long num = _strtol(handle->read_position, &endptr, 10);
-
-  // Check for various possible errors
-  if (endptr == handle->read_position || num < INT32_MIN || num > INT32_MAX) {
-    return E_CCURSOR_ERR_PARSE;
-  }
-
-  // Check if endptr is outside of the buffer
-  if (endptr > CCURSOR_END(handle)) {
-    return E_CCURSOR_ERR_PARSE;
-  }
-
-  *value = (int32_t)num;
-  handle->read_position = endptr;
-
-  return E_CCURSOR_OK;
+  return ccursor_read_signed(handle, _INT32_MAX, value);
 }
 
 ccursor_ret_t ccursor_read_i16(ccursor_handle_t *handle, int16_t *value) {
-  int32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_i32(handle, &num);
+  int32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_signed(handle, _INT16_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num >= _INT16_MIN || num <= _INT16_MAX) {
-      *value = (int16_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (int16_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
 ccursor_ret_t ccursor_read_i8(ccursor_handle_t *handle, int8_t *value) {
-  int32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_i32(handle, &num);
+  int32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_signed(handle, _INT8_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num >= _INT8_MIN || num <= _INT8_MAX) {
-      *value = (int8_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (int8_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
-ccursor_ret_t ccursor_read_u32_be(ccursor_handle_t *handle, uint32_t *value) {
-  if (handle == NULL || value == NULL ||
+ccursor_ret_t ccursor_read_decimal(ccursor_handle_t *handle, uint8_t scale,
+                                   ccursor_decimal_mode_t mode,
+                                   int64_t *value) {
+  if (handle == NULL || value == NULL || scale > CCURSOR_DECIMAL_MAX_SCALE ||
       handle->read_position >= CCURSOR_END(handle)) {
     return E_CCURSOR_ERR_PARAM;
   }
 
-  ccursor_ret_t ret;
-  char next = ' ';
-  uint8_t nibble = 0;
-  uint32_t num = 0;
-  char *const read_position_pre = handle->read_position;
-
-  ret = ccursor_trim_left(handle);
-  if (ret == E_CCURSOR_OK) {
-    // trimmed leading spaces
+  const char *endptr = ccursor_parse_decimal(
+      handle->read_position, CCURSOR_END(handle), scale, mode, value);
+  if (endptr == NULL) {
+    return E_CCURSOR_ERR_PARSE;
   }
 
-  ret = ccursor_skip_substr(handle, "0x");
-  if (ret == E_CCURSOR_OK) {
-    // skipped leading 0x of hex string
-  }
-
-  uint8_t idx = 0;
-  for (idx = 0; idx < (sizeof(uint32_t) * 2); idx++) {
-    ret = ccursor_read_char(handle, &next);
-    if (ret == E_CCURSOR_OK) {
-      bool converted = ccursor_hex_char_to_nibble(&nibble, next);
-      if (converted == true) {
-        num = num << 4 | nibble;
-      } else {
-        // current char is not a valid nibble, revert read
-        handle->read_position--;
-        break;
-      }
-    } else {
-      // nothing more to read
-      break;
-    }
-  }
+  handle->read_position = (char *)endptr;
+  return E_CCURSOR_OK;
+}
 
-  // if we have already read some nibbles, parsing is done
-  if (idx > 0) {
-    *value = num;
-    return E_CCURSOR_OK;
-  } else {
-    // parsing failed because first char was already crap
-    handle->read_position = read_position_pre;
-    return E_CCURSOR_ERR_PARSE;
+ccursor_ret_t ccursor_read_u32_be(ccursor_handle_t *handle, uint32_t *value) {
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
   }
+  return ccursor_read_hex(handle, _UINT32_MAX, value);
 }
 
 ccursor_ret_t ccursor_read_u16_be(ccursor_handle_t *handle, uint16_t *value) {
-  uint32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_u32_be(handle, &num);
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_hex(handle, _UINT16_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num <= _UINT16_MAX) {
-      *value = (uint16_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (uint16_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
 ccursor_ret_t ccursor_read_u8_be(ccursor_handle_t *handle, uint8_t *value) {
-  uint32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_u32_be(handle, &num);
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_hex(handle, _UINT8_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num <= _UINT8_MAX) {
-      *value = (uint8_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (uint8_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
 ccursor_ret_t ccursor_read_i32_be(ccursor_handle_t *handle, int32_t *value) {
-  return ccursor_read_u32_be(handle, (uint32_t *)value);
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_hex(handle, _UINT32_MAX, &num);
+  if (ret == E_CCURSOR_OK) {
+    *value = (int32_t)num;
+  }
+
+  return ret;
 }
 
 ccursor_ret_t ccursor_read_i16_be(ccursor_handle_t *handle, int16_t *value) {
-  int32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_i32_be(handle, &num);
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_hex(handle, _UINT16_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num >= _INT16_MIN || num <= _INT16_MAX) {
-      *value = (int16_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (int16_t)(uint16_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
 ccursor_ret_t ccursor_read_i8_be(ccursor_handle_t *handle, int8_t *value) {
-  int32_t num = 0;
-  char *const read_position_pre = handle->read_position;
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_i32_be(handle, &num);
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_hex(handle, _UINT8_MAX, &num);
   if (ret == E_CCURSOR_OK) {
-    if (num >= _INT8_MIN || num <= _INT8_MAX) {
-      *value = (int8_t)num;
-      return E_CCURSOR_OK;
-    }
+    *value = (int8_t)(uint8_t)num;
   }
 
-  handle->read_position = read_position_pre;
   return ret;
 }
 
@@ -317,8 +303,7 @@ ccursor_ret_t ccursor_read_u32_le(ccursor_handle_t *handle, uint32_t *value) {
   uint32_t num = 0;
   ccursor_ret_t ret = ccursor_read_u32_be(handle, &num);
   if (ret == E_CCURSOR_OK) {
-    ccursor_byte_swap((uint8_t *)&num, sizeof(uint32_t));
-    *value = num;
+    *value = _bswap32(num);
     return E_CCURSOR_OK;
   }
 
@@ -329,8 +314,7 @@ ccursor_ret_t ccursor_read_u16_le(ccursor_handle_t *handle, uint16_t *value) {
   uint16_t num = 0;
   ccursor_ret_t ret = ccursor_read_u16_be(handle, &num);
   if (ret == E_CCURSOR_OK) {
-    ccursor_byte_swap((uint8_t *)&num, sizeof(uint16_t));
-    *value = num;
+    *value = _bswap16(num);
     return E_CCURSOR_OK;
   }
   return ret;
@@ -340,7 +324,7 @@ ccursor_ret_t ccursor_read_u8_le(ccursor_handle_t *handle, uint8_t *value) {
   uint8_t num = 0;
   ccursor_ret_t ret = ccursor_read_u8_be(handle, &num);
   if (ret == E_CCURSOR_OK) {
-    ccursor_byte_swap((uint8_t *)&num, sizeof(uint8_t));
+    // a single byte has no byte order
     *value = num;
     return E_CCURSOR_OK;
   }
@@ -351,8 +335,7 @@ ccursor_ret_t ccursor_read_i32_le(ccursor_handle_t *handle, int32_t *value) {
   int32_t num = 0;
   ccursor_ret_t ret = ccursor_read_i32_be(handle, &num);
   if (ret == E_CCURSOR_OK) {
-    ccursor_byte_swap((uint8_t *)&num, sizeof(int32_t));
-    *value = num;
+    *value = (int32_t)_bswap32((uint32_t)num);
     return E_CCURSOR_OK;
   }
   return ret;
@@ -362,8 +345,7 @@ ccursor_ret_t ccursor_read_i16_le(ccursor_handle_t *handle, int16_t *value) {
   int16_t num = 0;
   ccursor_ret_t ret = ccursor_read_i16_be(handle, &num);
   if (ret == E_CCURSOR_OK) {
-    ccursor_byte_swap((uint8_t *)&num, sizeof(int16_t));
-    *value = num;
+    *value = (int16_t)_bswap16((uint16_t)num);
     return E_CCURSOR_OK;
   }
   return ret;
@@ -373,17 +355,13 @@ ccursor_ret_t ccursor_read_i8_le(ccursor_handle_t *handle, int8_t *value) {
   int8_t num = 0;
   ccursor_ret_t ret = ccursor_read_i8_be(handle, &num);
   if (ret == E_CCURSOR_OK) {
-    ccursor_byte_swap((uint8_t *)&num, sizeof(int8_t));
+    // a single byte has no byte order
     *value = num;
     return E_CCURSOR_OK;
   }
   return ret;
 }
 
-ccursor_ret_t ccursor_read_byte(ccursor_handle_t *handle, uint8_t *byte) {
-  return ccursor_read_char(handle, (char *)byte);
-}
-
 ccursor_ret_t ccursor_read_bool(ccursor_handle_t *handle, bool *value) {
   uint8_t num = 0;
   char *const read_position_pre = handle->read_position;
@@ -400,91 +378,127 @@ ccursor_ret_t ccursor_read_bool(ccursor_handle_t *handle, bool *value) {
   return ret;
 }
 
-ccursor_ret_t ccursor_read_char(ccursor_handle_t *handle, char *c) {
+ccursor_ret_t ccursor_skip_until_char(ccursor_handle_t *handle, uint8_t c) {
   if (handle == NULL || handle->read_position >= CCURSOR_END(handle)) {
     return E_CCURSOR_ERR_PARAM;
   }
 
-  *c = *handle->read_position;
-  handle->read_position++;
+  const char *found = ccursor_kernels->find_char(
+      handle->read_position, CCURSOR_END(handle), (char)c);
+  if (found == CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  // also skip the found character
+  handle->read_position = (char *)found + 1;
   return E_CCURSOR_OK;
 }
 
-ccursor_ret_t ccursor_skip_char(ccursor_handle_t *handle, char c) {
-  char next = ' ';
-  char *const read_position_pre = handle->read_position;
+ccursor_ret_t ccursor_skip_until_substr(ccursor_handle_t *handle,
+                                        const char *substr) {
+  if (handle == NULL || substr == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_read_char(handle, &next);
-  if (ret == E_CCURSOR_OK) {
-    if (next == c) {
-      // cursor already advanced in ccursor_read_char function
+  size_t length = _strlen(substr);
+  if (length > (size_t)CCURSOR_REMAINING_SIZE(handle)) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+  if (length == 0) {
+    return E_CCURSOR_OK;
+  }
+
+  // candidates are found by their first character, the rest is compared
+  const char *p = handle->read_position;
+  const char *const last = CCURSOR_END(handle) - length + 1;
+  while ((p = ccursor_kernels->find_char(p, last, substr[0])) != last) {
+    if (memcmp(p + 1, substr + 1, length - 1) == 0) {
+      handle->read_position = (char *)p + length;
       return E_CCURSOR_OK;
     }
+    p++;
   }
 
-  handle->read_position = read_position_pre;
   return E_CCURSOR_ERR_PARSE;
 }
 
-ccursor_ret_t ccursor_skip_until_char(ccursor_handle_t *handle, uint8_t c) {
+ccursor_ret_t ccursor_rfind_char(ccursor_handle_t *handle, uint8_t c) {
   if (handle == NULL || handle->read_position >= CCURSOR_END(handle)) {
     return E_CCURSOR_ERR_PARAM;
   }
 
-  ccursor_ret_t ret = false;
-  char next = ' ';
-  char *const read_position_pre = handle->read_position;
-
-  do {
-    ret = ccursor_read_char(handle, &next);
-    if (ret == E_CCURSOR_OK) {
-      if (next == c) {
-        // cursor already advanced in ccursor_read_char function
-        return E_CCURSOR_OK;
-      }
-    }
-  } while (ret == E_CCURSOR_OK);
+  const char *found = ccursor_kernels->rfind_char(
+      handle->read_position, CCURSOR_END(handle), (char)c);
+  if (found == CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARSE;
+  }
 
-  handle->read_position = read_position_pre;
-  return E_CCURSOR_ERR_PARSE;
+  handle->read_position = (char *)found + 1;
+  return E_CCURSOR_OK;
 }
 
-ccursor_ret_t ccursor_skip_until_substr(ccursor_handle_t *handle,
-                                        const char *substr) {
+ccursor_ret_t ccursor_rfind_substr(ccursor_handle_t *handle,
+                                   const char *substr) {
   if (handle == NULL || substr == NULL ||
       handle->read_position >= CCURSOR_END(handle)) {
     return E_CCURSOR_ERR_PARAM;
   }
 
-  size_t substr_length =
-      strnlen(substr, (CCURSOR_END(handle) - handle->read_position));
-  char *found_position = strstr(handle->read_position, substr);
-
-  // Check if the substring was found and if it's inside the buffer
-  if (found_position == NULL || found_position >= CCURSOR_END(handle) ||
-      (found_position + substr_length) > CCURSOR_END(handle)) {
+  size_t length = _strlen(substr);
+  if (length > (size_t)CCURSOR_REMAINING_SIZE(handle)) {
     return E_CCURSOR_ERR_PARSE;
   }
+  if (length == 0) {
+    handle->read_position = CCURSOR_END(handle);
+    return E_CCURSOR_OK;
+  }
+
+  // candidates are found backwards by their first character
+  const char *const first = handle->read_position;
+  const char *last = CCURSOR_END(handle) - length + 1;
+  const char *p;
+  while ((p = ccursor_kernels->rfind_char(first, last, substr[0])) != last) {
+    if (memcmp(p + 1, substr + 1, length - 1) == 0) {
+      handle->read_position = (char *)p + length;
+      return E_CCURSOR_OK;
+    }
+    last = p;
+  }
 
-  // Move the current position to the character following the found substring
-  handle->read_position = found_position + _strlen(substr);
+  return E_CCURSOR_ERR_PARSE;
+}
+
+ccursor_ret_t ccursor_trim_right_at_char(ccursor_handle_t *handle, uint8_t c) {
+  if (handle == NULL || handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
+  const char *found = ccursor_kernels->rfind_char(
+      handle->read_position, CCURSOR_END(handle), (char)c);
+  if (found == CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  handle->buffer_size = (uint32_t)(found - handle->buffer);
   return E_CCURSOR_OK;
 }
 
 ccursor_ret_t ccursor_skip_substr(ccursor_handle_t *handle,
                                   const char *substr) {
-  char *const read_position_pre = handle->read_position;
+  if (handle == NULL || substr == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
 
-  ccursor_ret_t ret = ccursor_skip_until_substr(handle, substr);
-  if (ret == E_CCURSOR_OK) {
-    if ((read_position_pre + _strlen(substr)) == handle->read_position) {
-      return E_CCURSOR_OK;
-    }
+  size_t length = _strlen(substr);
+  if (length > (size_t)CCURSOR_REMAINING_SIZE(handle) ||
+      memcmp(handle->read_position, substr, length) != 0) {
+    return E_CCURSOR_ERR_PARSE;
   }
 
-  handle->read_position = read_position_pre;
-  return E_CCURSOR_ERR_PARSE;
+  handle->read_position += length;
+  return E_CCURSOR_OK;
 }
 
 ccursor_ret_t ccursor_read_substr(ccursor_handle_t *handle, char *substr,
@@ -512,29 +526,26 @@ ccursor_ret_t ccursor_read_substr_until_char(ccursor_handle_t *handle,
       handle->read_position >= CCURSOR_END(handle)) {
     return E_CCURSOR_ERR_PARAM;
   }
-  char *const read_position_pre = handle->read_position;
 
   size_t remaining_size = CCURSOR_REMAINING_SIZE(handle);
   if (remaining_size < size) {
     size = remaining_size;
   }
 
-  size_t idx = 0;
-  for (idx = 0; idx < size; idx++) {
-    // also skip stop character
-    if (*(handle->read_position) == c) {
-      handle->read_position++;
-      substr[idx] = '\0';
-      *written = idx;
-      return E_CCURSOR_OK;
-    }
-    substr[idx] = *(handle->read_position);
-    handle->read_position++;
+  const char *found = ccursor_kernels->find_char(
+      handle->read_position, handle->read_position + size, c);
+  if (found == handle->read_position + size) {
+    // character not found and either buffer or cursor end reached
+    return E_CCURSOR_ERR_PARSE;
   }
 
-  // character not found and either buffer or cursor end reached
-  handle->read_position = read_position_pre;
-  return E_CCURSOR_ERR_PARSE;
+  // also skip stop character
+  size_t length = (size_t)(found - handle->read_position);
+  memcpy(substr, handle->read_position, length);
+  substr[length] = '\0';
+  *written = length;
+  handle->read_position = (char *)found + 1;
+  return E_CCURSOR_OK;
 }
 
 ccursor_ret_t ccursor_trim_left(ccursor_handle_t *handle) {
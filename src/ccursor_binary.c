@@ -0,0 +1,419 @@
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
+
+/**
+ * @brief Takes count raw elements of the given size from the stream
+ *
+ * @param[in,out] handle - The char cursor handle
+ * @param[in]     values - target of the caller, checked for NULL only
+ * @param[in]     count  - number of elements
+ * @param[in]     size   - size of a single element
+ * @param[out]    bytes  - first byte of the taken elements
+ * @return E_CCURSOR_RET_OK on success
+ * @return E_CCURSOR_ERR_PARAM if the handle or values is NULL
+ * @return E_CCURSOR_ERR_PARSE if not enough bytes are available
+ */
+static ccursor_ret_t ccursor_get_raw(ccursor_handle_t *handle,
+                                     const void *values, size_t count,
+                                     size_t size, const char **bytes) {
+  if (handle == NULL || values == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  if (count > (size_t)CCURSOR_REMAINING_SIZE(handle) / size) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  *bytes = handle->read_position;
+  handle->read_position += count * size;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_get_u16_le(ccursor_handle_t *handle, uint16_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint16_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = ccursor_le16_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_u16_be(ccursor_handle_t *handle, uint16_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint16_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = ccursor_be16_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_i16_le(ccursor_handle_t *handle, int16_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint16_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = (int16_t)ccursor_le16_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_i16_be(ccursor_handle_t *handle, int16_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint16_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = (int16_t)ccursor_be16_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_u32_le(ccursor_handle_t *handle, uint32_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint32_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = ccursor_le32_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_u32_be(ccursor_handle_t *handle, uint32_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint32_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = ccursor_be32_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_i32_le(ccursor_handle_t *handle, int32_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint32_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = (int32_t)ccursor_le32_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_i32_be(ccursor_handle_t *handle, int32_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint32_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = (int32_t)ccursor_be32_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_u64_le(ccursor_handle_t *handle, uint64_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint64_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = ccursor_le64_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_u64_be(ccursor_handle_t *handle, uint64_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint64_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = ccursor_be64_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_i64_le(ccursor_handle_t *handle, int64_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint64_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = (int64_t)ccursor_le64_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_i64_be(ccursor_handle_t *handle, int64_t *value) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret = ccursor_get_raw(handle, value, 1, sizeof(*value), &bytes);
+  if (ret == E_CCURSOR_OK) {
+    uint64_t raw;
+    memcpy(&raw, bytes, sizeof(raw));
+    *value = (int64_t)ccursor_be64_to_host(raw);
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_array_u16_le(ccursor_handle_t *handle,
+                                       uint16_t *values, size_t count) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret =
+      ccursor_get_raw(handle, values, count, sizeof(*values), &bytes);
+  if (ret == E_CCURSOR_OK) {
+#if _IS_LITTLE_ENDIAN
+    memcpy(values, bytes, count * sizeof(*values));
+#else
+    ccursor_kernels->swap_array16(values, bytes, count);
+#endif
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_array_u16_be(ccursor_handle_t *handle,
+                                       uint16_t *values, size_t count) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret =
+      ccursor_get_raw(handle, values, count, sizeof(*values), &bytes);
+  if (ret == E_CCURSOR_OK) {
+#if !_IS_LITTLE_ENDIAN
+    memcpy(values, bytes, count * sizeof(*values));
+#else
+    ccursor_kernels->swap_array16(values, bytes, count);
+#endif
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_array_u32_le(ccursor_handle_t *handle,
+                                       uint32_t *values, size_t count) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret =
+      ccursor_get_raw(handle, values, count, sizeof(*values), &bytes);
+  if (ret == E_CCURSOR_OK) {
+#if _IS_LITTLE_ENDIAN
+    memcpy(values, bytes, count * sizeof(*values));
+#else
+    ccursor_kernels->swap_array32(values, bytes, count);
+#endif
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_array_u32_be(ccursor_handle_t *handle,
+                                       uint32_t *values, size_t count) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret =
+      ccursor_get_raw(handle, values, count, sizeof(*values), &bytes);
+  if (ret == E_CCURSOR_OK) {
+#if !_IS_LITTLE_ENDIAN
+    memcpy(values, bytes, count * sizeof(*values));
+#else
+    ccursor_kernels->swap_array32(values, bytes, count);
+#endif
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_array_u64_le(ccursor_handle_t *handle,
+                                       uint64_t *values, size_t count) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret =
+      ccursor_get_raw(handle, values, count, sizeof(*values), &bytes);
+  if (ret == E_CCURSOR_OK) {
+#if _IS_LITTLE_ENDIAN
+    memcpy(values, bytes, count * sizeof(*values));
+#else
+    ccursor_kernels->swap_array64(values, bytes, count);
+#endif
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_get_array_u64_be(ccursor_handle_t *handle,
+                                       uint64_t *values, size_t count) {
+  const char *bytes = NULL;
+  ccursor_ret_t ret =
+      ccursor_get_raw(handle, values, count, sizeof(*values), &bytes);
+  if (ret == E_CCURSOR_OK) {
+#if !_IS_LITTLE_ENDIAN
+    memcpy(values, bytes, count * sizeof(*values));
+#else
+    ccursor_kernels->swap_array64(values, bytes, count);
+#endif
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Decodes a single LEB128 varint
+ *
+ * @param[in]  p     - first byte of the varint
+ * @param[in]  end   - end of the readable area
+ * @param[in]  bits  - width of the target type, 32 or 64
+ * @param[out] value - decoded value
+ * @return pointer behind the varint on success, NULL if the varint is
+ *         truncated or exceeds the target width
+ */
+static const char *ccursor_decode_varint(const char *p, const char *end,
+                                         uint8_t bits, uint64_t *value) {
+  const uint8_t max_bytes = (bits + 6) / 7;
+  uint64_t num = 0;
+
+  for (uint8_t idx = 0; idx < max_bytes && p < end; idx++) {
+    uint8_t byte = (uint8_t)*p++;
+    num |= (uint64_t)(byte & 0x7F) << (7 * idx);
+    if ((byte & 0x80) == 0) {
+      // the last group must not exceed the target width
+      if (idx == max_bytes - 1 && (byte >> (bits - 7 * idx)) != 0) {
+        return NULL;
+      }
+      *value = num;
+      return p;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Decodes count LEB128 varints of at most 32 bits
+ *
+ * The bulk is decoded by the block kernel of the active instruction set,
+ * the remainder near the end by the scalar decoder.
+ *
+ * @param[in]  p      - first byte of the varints
+ * @param[in]  end    - end of the readable area
+ * @param[out] values - decoded values
+ * @param[in]  count  - number of varints to decode
+ * @return pointer behind the last varint on success, else NULL
+ */
+static const char *ccursor_decode_varints32(const char *p, const char *end,
+                                            uint32_t *values, size_t count) {
+  size_t idx = 0;
+  p = ccursor_kernels->decode_varints32(p, end, values, count, &idx);
+  if (p == NULL) {
+    return NULL;
+  }
+
+  for (; idx < count; idx++) {
+    uint64_t num = 0;
+    p = ccursor_decode_varint(p, end, 32, &num);
+    if (p == NULL) {
+      return NULL;
+    }
+    values[idx] = (uint32_t)num;
+  }
+
+  return p;
+}
+
+ccursor_ret_t ccursor_read_varint_u32(ccursor_handle_t *handle,
+                                      uint32_t *value) {
+  if (handle == NULL || value == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  uint64_t num = 0;
+  const char *endptr = ccursor_decode_varint(handle->read_position,
+                                             CCURSOR_END(handle), 32, &num);
+  if (endptr == NULL) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  *value = (uint32_t)num;
+  handle->read_position = (char *)endptr;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_read_varint_u64(ccursor_handle_t *handle,
+                                      uint64_t *value) {
+  if (handle == NULL || value == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  uint64_t num = 0;
+  const char *endptr = ccursor_decode_varint(handle->read_position,
+                                             CCURSOR_END(handle), 64, &num);
+  if (endptr == NULL) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  *value = num;
+  handle->read_position = (char *)endptr;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_read_varint_i32(ccursor_handle_t *handle,
+                                      int32_t *value) {
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  uint32_t num = 0;
+  ccursor_ret_t ret = ccursor_read_varint_u32(handle, &num);
+  if (ret == E_CCURSOR_OK) {
+    *value = (int32_t)((num >> 1) ^ (0 - (num & 1)));
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_read_varint_i64(ccursor_handle_t *handle,
+                                      int64_t *value) {
+  if (value == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  uint64_t num = 0;
+  ccursor_ret_t ret = ccursor_read_varint_u64(handle, &num);
+  if (ret == E_CCURSOR_OK) {
+    *value = (int64_t)((num >> 1) ^ (0 - (num & 1)));
+  }
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_read_varints(ccursor_handle_t *handle, uint32_t *values,
+                                   size_t count) {
+  if (handle == NULL || values == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const char *endptr = ccursor_decode_varints32(
+      handle->read_position, CCURSOR_END(handle), values, count);
+  if (endptr == NULL) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  handle->read_position = (char *)endptr;
+  return E_CCURSOR_OK;
+}
@@ -0,0 +1,80 @@
+#include "ccursor_kernels.h"
+
+/**
+ * @brief Kernel table used until the selection below ran
+ *
+ * SSE2 is part of the x86-64 baseline, every other build starts with the
+ * portable kernels.
+ */
+#if defined(CCURSOR_X86_KERNELS) && defined(__x86_64__)
+const ccursor_kernels_t *ccursor_kernels = &ccursor_kernels_sse2;
+#else
+const ccursor_kernels_t *ccursor_kernels = &ccursor_kernels_scalar;
+#endif
+
+#if defined(CCURSOR_X86_KERNELS)
+/**
+ * @brief Checks if the running CPU supports the kernels of a table
+ *
+ * @param[in] kernels - kernel table to check
+ * @return true if the kernels can be executed, else false
+ */
+static bool ccursor_kernels_supported(const ccursor_kernels_t *kernels) {
+  if (kernels == &ccursor_kernels_avx512) {
+    return _cpu_supports("avx512f") && _cpu_supports("avx512bw");
+  } else if (kernels == &ccursor_kernels_avx2) {
+    return _cpu_supports("avx2");
+  } else if (kernels == &ccursor_kernels_sse2) {
+    return _cpu_supports("sse2");
+  }
+  return true;
+}
+#endif
+
+/**
+ * @brief Selects the widest kernels supported by the CPU once at load time
+ *
+ * The environment variable CCURSOR_FORCE_ISA limits the selection to the
+ * named instruction set, e.g. to compare or test the kernels. Unknown or
+ * unsupported names are ignored.
+ */
+__attribute__((constructor)) static void ccursor_kernels_select(void) {
+  const ccursor_kernels_t *candidates[] = {
+#if defined(CCURSOR_X86_KERNELS)
+      &ccursor_kernels_avx512,
+      &ccursor_kernels_avx2,
+      &ccursor_kernels_sse2,
+#endif
+      &ccursor_kernels_scalar,
+  };
+  const size_t count = sizeof(candidates) / sizeof(candidates[0]);
+
+#if defined(CCURSOR_X86_KERNELS)
+  _cpu_init();
+#endif
+
+  const char *forced = _getenv("CCURSOR_FORCE_ISA");
+  for (size_t idx = 0; forced != NULL && idx < count; idx++) {
+    if (_strcmp(forced, candidates[idx]->isa) == 0) {
+#if defined(CCURSOR_X86_KERNELS)
+      if (!ccursor_kernels_supported(candidates[idx])) {
+        break;
+      }
+#endif
+      ccursor_kernels = candidates[idx];
+      return;
+    }
+  }
+
+  for (size_t idx = 0; idx < count; idx++) {
+#if defined(CCURSOR_X86_KERNELS)
+    if (!ccursor_kernels_supported(candidates[idx])) {
+      continue;
+    }
+#endif
+    ccursor_kernels = candidates[idx];
+    return;
+  }
+}
+
+const char *ccursor_active_isa(void) { return ccursor_kernels->isa; }
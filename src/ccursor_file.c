@@ -0,0 +1,339 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
+
+#include "ccursor_file.h"
+#include "ccursor_unchecked.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// identifies version 1 of the sidecar layout
+#define CCURSOR_FILE_MAGIC "CCLIDX01"
+// magic, file size, modification time, lines, interval and sample count
+#define CCURSOR_FILE_HEADER_SIZE (8 + 8 + 8 + 8 + 8 + 4 + 8)
+// longest LEB128 encoding of an uint64_t
+#define CCURSOR_FILE_VARINT_MAX 10
+
+/**
+ * @brief Skips a number of lines
+ *
+ * Blocks of 64 characters are skipped by counting their '\n', only the block
+ * holding the wanted '\n' is looked at bit by bit.
+ *
+ * @param[in] p     - first character to inspect
+ * @param[in] end   - end of the mapped file
+ * @param[in] count - number of lines to skip, at least 1
+ * @return pointer behind the last skipped '\n', NULL if the file ends before
+ */
+static const char *ccursor_file_skip_lines(const char *p, const char *end,
+                                           uint64_t count) {
+  while (end - p >= 64) {
+    uint64_t newlines = ccursor_kernels->match_mask(p, '\n', '\n');
+    uint64_t found = (uint64_t)_popcount64(newlines);
+    if (found >= count) {
+      while (--count > 0) {
+        newlines &= newlines - 1;
+      }
+      return p + _ctz64(newlines) + 1;
+    }
+    count -= found;
+    p += 64;
+  }
+
+  for (; p < end; p++) {
+    if (*p == '\n' && --count == 0) {
+      return p + 1;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Builds the sampled line index of a mapped file
+ *
+ * @param[in,out] file - mapped file, the interval is set by the caller
+ * @return E_CCURSOR_RET_OK on success, else E_CCURSOR_ERR
+ */
+static ccursor_ret_t ccursor_file_build(ccursor_file_t *file) {
+  const char *const end = file->data + file->size;
+  file->lines = ccursor_kernels->count_char(file->data, end, '\n') +
+                (*(end - 1) != '\n');
+  file->sample_count =
+      (size_t)((file->lines + file->interval - 1) / file->interval);
+  file->samples = malloc(file->sample_count * sizeof(uint64_t));
+  if (file->samples == NULL) {
+    return E_CCURSOR_ERR;
+  }
+
+  const char *p = file->data;
+  file->samples[0] = 0;
+  for (size_t idx = 1; idx < file->sample_count; idx++) {
+    p = ccursor_file_skip_lines(p, end, file->interval);
+    file->samples[idx] = (uint64_t)(p - file->data);
+  }
+
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Appends an uint64_t as LEB128 varint
+ *
+ * @param[out] p     - target with room for CCURSOR_FILE_VARINT_MAX bytes
+ * @param[in]  value - value to encode
+ * @return pointer behind the varint
+ */
+static char *ccursor_file_put_varint(char *p, uint64_t value) {
+  while (value >= 0x80) {
+    *p++ = (char)((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  *p++ = (char)value;
+  return p;
+}
+
+/**
+ * @brief Appends an integer in little-endian byte order
+ *
+ * @param[out] p     - target with room for size bytes
+ * @param[in]  value - value to encode
+ * @param[in]  size  - number of bytes to append
+ * @return pointer behind the integer
+ */
+static char *ccursor_file_put_le(char *p, uint64_t value, size_t size) {
+  for (size_t idx = 0; idx < size; idx++) {
+    *p++ = (char)(value >> (8 * idx));
+  }
+  return p;
+}
+
+/**
+ * @brief Writes the line index into the sidecar, replacing it atomically
+ *
+ * @param[in] file    - mapped file with its line index
+ * @param[in] sidecar - path of the sidecar
+ * @param[in] st      - status of the mapped file
+ */
+static void ccursor_file_store(const ccursor_file_t *file, const char *sidecar,
+                               const struct stat *st) {
+  size_t capacity = CCURSOR_FILE_HEADER_SIZE +
+                    file->sample_count * CCURSOR_FILE_VARINT_MAX;
+  char *buffer = malloc(capacity);
+  if (buffer == NULL) {
+    return;
+  }
+
+  char *p = buffer;
+  memcpy(p, CCURSOR_FILE_MAGIC, 8);
+  p += 8;
+  p = ccursor_file_put_le(p, (uint64_t)st->st_size, 8);
+  p = ccursor_file_put_le(p, (uint64_t)st->st_mtim.tv_sec, 8);
+  p = ccursor_file_put_le(p, (uint64_t)st->st_mtim.tv_nsec, 8);
+  p = ccursor_file_put_le(p, file->lines, 8);
+  p = ccursor_file_put_le(p, file->interval, 4);
+  p = ccursor_file_put_le(p, file->sample_count, 8);
+  for (size_t idx = 0; idx < file->sample_count; idx++) {
+    uint64_t previous = (idx > 0) ? file->samples[idx - 1] : 0;
+    p = ccursor_file_put_varint(p, file->samples[idx] - previous);
+  }
+
+  char temporary[4096];
+  int length = _snprintf(temporary, sizeof(temporary), "%s.tmp", sidecar);
+  if (length > 0 && (size_t)length < sizeof(temporary)) {
+    FILE *out = fopen(temporary, "wb");
+    if (out != NULL) {
+      bool written = fwrite(buffer, 1, (size_t)(p - buffer), out) ==
+                     (size_t)(p - buffer);
+      written = (fclose(out) == 0) && written;
+      if (!written || rename(temporary, sidecar) != 0) {
+        remove(temporary);
+      }
+    }
+  }
+
+  free(buffer);
+}
+
+/**
+ * @brief Loads the line index from the sidecar if it matches the file
+ *
+ * @param[in,out] file    - mapped file
+ * @param[in]     sidecar - path of the sidecar
+ * @param[in]     st      - status of the mapped file
+ * @return E_CCURSOR_RET_OK on success, E_CCURSOR_ERR if the sidecar is
+ *         missing, invalid or stale
+ */
+static ccursor_ret_t ccursor_file_load(ccursor_file_t *file,
+                                       const char *sidecar,
+                                       const struct stat *st) {
+  FILE *in = fopen(sidecar, "rb");
+  if (in == NULL) {
+    return E_CCURSOR_ERR;
+  }
+
+  // the sidecar is small, read it as a whole and parse it with a cursor
+  char *buffer = NULL;
+  long size = -1;
+  if (fseek(in, 0, SEEK_END) == 0 && (size = ftell(in)) > 0 &&
+      size < (long)_UINT32_MAX && fseek(in, 0, SEEK_SET) == 0) {
+    buffer = malloc((size_t)size + 1);
+  }
+  if (buffer == NULL || fread(buffer, 1, (size_t)size, in) != (size_t)size) {
+    free(buffer);
+    fclose(in);
+    return E_CCURSOR_ERR;
+  }
+  fclose(in);
+  buffer[size] = '\0';
+
+  ccursor_handle_t handle;
+  ccursor_unchecked_t header;
+  ccursor_ret_t ret = ccursor_init(&handle, buffer, (uint32_t)size);
+  if (ret == E_CCURSOR_OK) {
+    ret = ccursor_reserve(&handle, CCURSOR_FILE_HEADER_SIZE, &header);
+  }
+  if (ret == E_CCURSOR_OK) {
+    bool magic = memcmp(header.read_position, CCURSOR_FILE_MAGIC, 8) == 0;
+    ccursor_skip_unchecked(&header, 8);
+    bool fresh =
+        ccursor_get_u64_le_unchecked(&header) == (uint64_t)st->st_size &&
+        ccursor_get_u64_le_unchecked(&header) ==
+            (uint64_t)st->st_mtim.tv_sec &&
+        ccursor_get_u64_le_unchecked(&header) ==
+            (uint64_t)st->st_mtim.tv_nsec;
+    file->lines = ccursor_get_u64_le_unchecked(&header);
+    file->interval = ccursor_get_u32_le_unchecked(&header);
+    uint64_t count = ccursor_get_u64_le_unchecked(&header);
+
+    ret = E_CCURSOR_ERR;
+    if (magic && fresh && file->interval != 0 &&
+        count == (file->lines + file->interval - 1) / file->interval &&
+        count <= (uint64_t)CCURSOR_REMAINING_SIZE((&handle))) {
+      file->sample_count = (size_t)count;
+      file->samples = malloc(file->sample_count * sizeof(uint64_t));
+      ret = (file->samples != NULL) ? E_CCURSOR_OK : E_CCURSOR_ERR;
+    }
+  }
+
+  uint64_t offset = 0;
+  for (size_t idx = 0; ret == E_CCURSOR_OK && idx < file->sample_count;
+       idx++) {
+    uint64_t delta = 0;
+    ret = ccursor_read_varint_u64(&handle, &delta);
+    offset += delta;
+    file->samples[idx] = offset;
+    // a sample starts the file or follows a line break, else the file was
+    // rewritten without changing its size and modification time
+    if (ret == E_CCURSOR_OK &&
+        (offset >= file->size ||
+         (offset > 0 && file->data[offset - 1] != '\n'))) {
+      ret = E_CCURSOR_ERR;
+    }
+  }
+
+  if (ret != E_CCURSOR_OK) {
+    free(file->samples);
+    file->samples = NULL;
+    ret = E_CCURSOR_ERR;
+  }
+  free(buffer);
+  return ret;
+}
+
+ccursor_ret_t ccursor_file_open(ccursor_file_t *file, const char *path,
+                                uint32_t interval) {
+  if (file == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  memset(file, 0, sizeof(ccursor_file_t));
+
+  if (path == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return E_CCURSOR_ERR;
+  }
+
+  struct stat st;
+  void *data = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (data == MAP_FAILED) {
+    return E_CCURSOR_ERR;
+  }
+
+  file->data = data;
+  file->size = (size_t)st.st_size;
+
+  char sidecar[4096];
+  int length = _snprintf(sidecar, sizeof(sidecar), "%s.ccidx", path);
+  bool named = (length > 0 && (size_t)length < sizeof(sidecar));
+  if (named && ccursor_file_load(file, sidecar, &st) == E_CCURSOR_OK) {
+    return E_CCURSOR_OK;
+  }
+
+  file->interval = (interval != 0) ? interval : CCURSOR_FILE_DEFAULT_INTERVAL;
+  if (ccursor_file_build(file) != E_CCURSOR_OK) {
+    ccursor_file_close(file);
+    return E_CCURSOR_ERR;
+  }
+  if (named) {
+    ccursor_file_store(file, sidecar, &st);
+  }
+
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_file_lines(const ccursor_file_t *file, uint64_t first,
+                                 uint64_t count, ccursor_handle_t *lines) {
+  if (file == NULL || lines == NULL || count == 0) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  if (first >= file->lines) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  const char *const end = file->data + file->size;
+  const char *begin = file->data + file->samples[first / file->interval];
+  if (first % file->interval != 0) {
+    begin = ccursor_file_skip_lines(begin, end, first % file->interval);
+  }
+  if (begin == NULL) {
+    // the file has fewer lines than indexed
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  const char *last = ccursor_file_skip_lines(begin, end, count);
+  if (last == NULL) {
+    last = end;
+  }
+  if ((uint64_t)(last - begin) > _UINT32_MAX) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  lines->buffer = (char *)begin;
+  lines->buffer_size = (uint32_t)(last - begin);
+  lines->read_position = lines->buffer;
+  return E_CCURSOR_OK;
+}
+
+void ccursor_file_close(ccursor_file_t *file) {
+  if (file == NULL) {
+    return;
+  }
+
+  if (file->data != NULL) {
+    munmap(file->data, file->size);
+  }
+  free(file->samples);
+  memset(file, 0, sizeof(ccursor_file_t));
+}
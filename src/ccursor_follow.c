@@ -0,0 +1,291 @@
+#define _GNU_SOURCE
+
+#include "ccursor_internal.h"
+
+#include "ccursor_follow.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// events of the followed file, any of them wakes up the reader
+#define CCURSOR_FOLLOW_FILE_EVENTS                                             \
+  (IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF)
+// events of the directory announcing a new file at the followed path
+#define CCURSOR_FOLLOW_DIR_EVENTS (IN_CREATE | IN_MOVED_TO)
+
+/**
+ * @brief Opens the file at the followed path and watches it
+ *
+ * @param[in,out] follow - follow state, the previous file is closed
+ * @return E_CCURSOR_RET_OK on success, else E_CCURSOR_ERR
+ */
+static ccursor_ret_t ccursor_follow_attach(ccursor_follow_t *follow) {
+  int fd = open(follow->path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return E_CCURSOR_ERR;
+  }
+
+  int watch = inotify_add_watch(follow->notify, follow->path,
+                                CCURSOR_FOLLOW_FILE_EVENTS);
+  if (watch < 0) {
+    close(fd);
+    return E_CCURSOR_ERR;
+  }
+
+  // the watch of a removed file is gone already, so failing is fine
+  if (follow->file_watch >= 0 && follow->file_watch != watch) {
+    inotify_rm_watch(follow->notify, follow->file_watch);
+  }
+  if (follow->fd >= 0) {
+    close(follow->fd);
+  }
+
+  follow->fd = fd;
+  follow->file_watch = watch;
+  follow->offset = 0;
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Checks if a new file took the place of the currently read one
+ *
+ * @param[in] follow - follow state
+ * @return true if the path refers to another file, else false
+ */
+static bool ccursor_follow_rotated(const ccursor_follow_t *follow) {
+  struct stat current;
+  struct stat named;
+  if (fstat(follow->fd, &current) != 0 || stat(follow->path, &named) != 0) {
+    return false;
+  }
+  return current.st_ino != named.st_ino || current.st_dev != named.st_dev;
+}
+
+/**
+ * @brief Reads the bytes appended since the last read
+ *
+ * @param[in,out] follow   - follow state
+ * @param[out]    appended - number of bytes appended to the buffer
+ * @return E_CCURSOR_RET_OK on success, else E_CCURSOR_ERR
+ */
+static ccursor_ret_t ccursor_follow_read(ccursor_follow_t *follow,
+                                         size_t *appended) {
+  *appended = 0;
+
+  // a file shorter than the read offset has been truncated
+  struct stat st;
+  if (fstat(follow->fd, &st) != 0) {
+    return E_CCURSOR_ERR;
+  }
+  if ((uint64_t)st.st_size < follow->offset) {
+    follow->offset = 0;
+    follow->pending = 0;
+    follow->discard = false;
+  }
+
+  if (follow->pending == _UINT32_MAX) {
+    return E_CCURSOR_ERR;
+  }
+  size_t chunk = CCURSOR_FOLLOW_CHUNK;
+  if (chunk > _UINT32_MAX - follow->pending) {
+    chunk = _UINT32_MAX - follow->pending;
+  }
+  if (follow->capacity - follow->pending < chunk) {
+    size_t capacity = follow->pending + chunk;
+    char *buffer = realloc(follow->buffer, capacity);
+    if (buffer == NULL) {
+      return E_CCURSOR_ERR;
+    }
+    follow->buffer = buffer;
+    follow->capacity = capacity;
+  }
+
+  ssize_t size = pread(follow->fd, follow->buffer + follow->pending, chunk,
+                       (off_t)follow->offset);
+  if (size < 0) {
+    return E_CCURSOR_ERR;
+  }
+  follow->offset += (uint64_t)size;
+  follow->pending += (size_t)size;
+  *appended = (size_t)size;
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Waits for events of the followed file or its directory
+ *
+ * @param[in] follow   - follow state
+ * @param[in] deadline - end of the wait on the monotonic clock in
+ *                       milliseconds, negative to wait forever
+ * @return true if events arrived, false on timeout or error
+ */
+static bool ccursor_follow_wait(const ccursor_follow_t *follow,
+                                int64_t deadline) {
+  int timeout = -1;
+  if (deadline >= 0) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t left = deadline - (now.tv_sec * 1000 + now.tv_nsec / 1000000);
+    timeout = (left > 0) ? (int)((left < INT_MAX) ? left : INT_MAX) : 0;
+  }
+
+  struct pollfd poll_fd = {.fd = follow->notify, .events = POLLIN};
+  if (poll(&poll_fd, 1, timeout) <= 0) {
+    return false;
+  }
+
+  // the events are only wake-ups, the state is checked after reading them
+  char events[sizeof(struct inotify_event) + NAME_MAX + 1]
+      __attribute__((aligned(__alignof__(struct inotify_event))));
+  while (read(follow->notify, events, sizeof(events)) > 0) {
+  }
+  return true;
+}
+
+ccursor_ret_t ccursor_follow_open(ccursor_follow_t *follow, const char *path,
+                                  bool from_end) {
+  if (follow == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  memset(follow, 0, sizeof(ccursor_follow_t));
+  follow->fd = -1;
+  follow->notify = -1;
+  follow->file_watch = -1;
+  follow->dir_watch = -1;
+
+  if (path == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  follow->path = strdup(path);
+  follow->notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (follow->path == NULL || follow->notify < 0 ||
+      ccursor_follow_attach(follow) != E_CCURSOR_OK) {
+    ccursor_follow_close(follow);
+    return E_CCURSOR_ERR;
+  }
+
+  // watch the directory to notice a new file after a rotation
+  const char *slash = strrchr(path, '/');
+  char *directory = (slash == NULL) ? strdup(".")
+                    : (slash == path) ? strdup("/")
+                                      : strndup(path, (size_t)(slash - path));
+  if (directory != NULL) {
+    follow->dir_watch = inotify_add_watch(follow->notify, directory,
+                                          CCURSOR_FOLLOW_DIR_EVENTS);
+    free(directory);
+  }
+  if (follow->dir_watch < 0) {
+    ccursor_follow_close(follow);
+    return E_CCURSOR_ERR;
+  }
+
+  struct stat st;
+  if (from_end && fstat(follow->fd, &st) == 0 && st.st_size > 0) {
+    char last = '\n';
+    follow->offset = (uint64_t)st.st_size;
+    if (pread(follow->fd, &last, 1, st.st_size - 1) != 1 || last != '\n') {
+      follow->discard = true;
+    }
+  }
+
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_follow_next(ccursor_follow_t *follow, int timeout,
+                                  ccursor_handle_t *lines) {
+  if (follow == NULL || lines == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  int64_t deadline = -1;
+  if (timeout >= 0) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    deadline = now.tv_sec * 1000 + now.tv_nsec / 1000000 + timeout;
+  }
+
+  // release the lines handed out by the last call
+  if (follow->consumed > 0) {
+    memmove(follow->buffer, follow->buffer + follow->consumed,
+            follow->pending - follow->consumed);
+    follow->pending -= follow->consumed;
+    follow->consumed = 0;
+  }
+
+  while (true) {
+    size_t appended = 0;
+    if (ccursor_follow_read(follow, &appended) != E_CCURSOR_OK) {
+      return E_CCURSOR_ERR;
+    }
+
+    if (follow->discard) {
+      const char *newline = memchr(follow->buffer, '\n', follow->pending);
+      size_t dropped = (newline != NULL)
+                           ? (size_t)(newline - follow->buffer) + 1
+                           : follow->pending;
+      memmove(follow->buffer, follow->buffer + dropped,
+              follow->pending - dropped);
+      follow->pending -= dropped;
+      follow->discard = (newline == NULL);
+      appended = (appended < follow->pending) ? appended : follow->pending;
+    }
+
+    // only the appended bytes can hold a new '\n'
+    size_t complete = 0;
+    const size_t scanned = follow->pending - appended;
+    for (size_t idx = follow->pending; idx > scanned; idx--) {
+      if (follow->buffer[idx - 1] == '\n') {
+        complete = idx;
+        break;
+      }
+    }
+    if (complete == 0 && appended == 0 && ccursor_follow_rotated(follow) &&
+        ccursor_follow_attach(follow) == E_CCURSOR_OK) {
+      // the old file is read up to its end, its incomplete line is final
+      follow->discard = false;
+      if (follow->pending == 0) {
+        continue;
+      }
+      complete = follow->pending;
+    }
+
+    if (complete > 0) {
+      follow->consumed = complete;
+      lines->buffer = follow->buffer;
+      lines->buffer_size = (uint32_t)complete;
+      lines->read_position = lines->buffer;
+      return E_CCURSOR_OK;
+    }
+
+    if (appended == 0 && !ccursor_follow_wait(follow, deadline)) {
+      return E_CCURSOR_ERR_PARSE;
+    }
+  }
+}
+
+void ccursor_follow_close(ccursor_follow_t *follow) {
+  if (follow == NULL) {
+    return;
+  }
+
+  if (follow->fd >= 0) {
+    close(follow->fd);
+  }
+  if (follow->notify >= 0) {
+    close(follow->notify);
+  }
+  free(follow->path);
+  free(follow->buffer);
+  memset(follow, 0, sizeof(ccursor_follow_t));
+  follow->fd = -1;
+  follow->notify = -1;
+  follow->file_watch = -1;
+  follow->dir_watch = -1;
+}
@@ -0,0 +1,395 @@
+#ifndef CCURSOR_INTERNAL_H
+#define CCURSOR_INTERNAL_H
+
+#include "ccursor.h"
+#include "ccursor_port.h"
+
+#define CCURSOR_END(handle) (handle->buffer + handle->buffer_size)
+#define CCURSOR_REMAINING_SIZE(handle)                                         \
+  (CCURSOR_END(handle) - handle->read_position)
+
+/**
+ * @brief Checks if a character is a decimal digit
+ *
+ * @param[in] c - character to check
+ * @return true if c is within '0'..'9', else false
+ */
+static inline bool ccursor_is_digit(const char c) {
+  return (uint8_t)(c - '0') < 10;
+}
+
+/**
+ * @brief Checks if a character is a whitespace as defined by the C locale
+ *
+ * @param[in] c - character to check
+ * @return true if c is one of ' ', '\t', '\n', '\v', '\f' or '\r'
+ */
+static inline bool ccursor_is_space(const char c) {
+  return c == ' ' || (uint8_t)(c - '\t') < 5;
+}
+
+/**
+ * @brief Loads 8 characters into an integer, first character in the low byte
+ *
+ * @param[in] p - pointer to at least 8 readable characters
+ * @return the loaded characters
+ */
+static inline uint64_t ccursor_load_chars(const char *p) {
+  uint64_t chunk;
+  memcpy(&chunk, p, sizeof(chunk));
+#if !_IS_LITTLE_ENDIAN
+  chunk = _bswap64(chunk);
+#endif
+  return chunk;
+}
+
+/**
+ * @brief Converts little-endian and big-endian values into host byte order
+ *
+ * @param[in] value - value in the named byte order
+ * @return value in host byte order
+ */
+static inline uint16_t ccursor_le16_to_host(const uint16_t value) {
+#if _IS_LITTLE_ENDIAN
+  return value;
+#else
+  return _bswap16(value);
+#endif
+}
+
+static inline uint32_t ccursor_le32_to_host(const uint32_t value) {
+#if _IS_LITTLE_ENDIAN
+  return value;
+#else
+  return _bswap32(value);
+#endif
+}
+
+static inline uint64_t ccursor_le64_to_host(const uint64_t value) {
+#if _IS_LITTLE_ENDIAN
+  return value;
+#else
+  return _bswap64(value);
+#endif
+}
+
+static inline uint16_t ccursor_be16_to_host(const uint16_t value) {
+#if _IS_LITTLE_ENDIAN
+  return _bswap16(value);
+#else
+  return value;
+#endif
+}
+
+static inline uint32_t ccursor_be32_to_host(const uint32_t value) {
+#if _IS_LITTLE_ENDIAN
+  return _bswap32(value);
+#else
+  return value;
+#endif
+}
+
+static inline uint64_t ccursor_be64_to_host(const uint64_t value) {
+#if _IS_LITTLE_ENDIAN
+  return _bswap64(value);
+#else
+  return value;
+#endif
+}
+
+/**
+ * @brief Checks if 8 loaded characters are all decimal digits (SWAR)
+ *
+ * @param[in] chunk - characters loaded via ccursor_load_chars
+ * @return true if all 8 characters are digits, else false
+ */
+static inline bool ccursor_swar_is_8digits(const uint64_t chunk) {
+  return (((chunk + 0x4646464646464646ULL) | (chunk - 0x3030303030303030ULL)) &
+          0x8080808080808080ULL) == 0;
+}
+
+/**
+ * @brief Converts 8 loaded digit characters into their value (SWAR)
+ *
+ * @param[in] chunk - characters loaded via ccursor_load_chars, all digits
+ * @return the decimal value of the 8 digits
+ */
+static inline uint32_t ccursor_swar_parse_8digits(uint64_t chunk) {
+  const uint64_t mask = 0x000000FF000000FFULL;
+  const uint64_t mul1 = 100 + (1000000ULL << 32);
+  const uint64_t mul2 = 1 + (10000ULL << 32);
+
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+  return (uint32_t)chunk;
+}
+
+/**
+ * @brief Accumulates a run of decimal digits into a value
+ *
+ * Consumes digits eight at a time while enough characters are left before
+ * end, the tail is consumed one by one. The value wraps around on overflow,
+ * callers have to bound the number of digits themselves.
+ *
+ * @param[in]     p     - first character to inspect
+ * @param[in]     end   - end of the readable area
+ * @param[in,out] value - value to accumulate the digits into
+ * @return pointer to the first character which is not a digit
+ */
+static inline const char *ccursor_accumulate_digits(const char *p,
+                                                    const char *end,
+                                                    uint64_t *value) {
+  uint64_t num = *value;
+
+  while (end - p >= 8) {
+    uint64_t chunk = ccursor_load_chars(p);
+    if (!ccursor_swar_is_8digits(chunk)) {
+      break;
+    }
+    num = num * 100000000ULL + ccursor_swar_parse_8digits(chunk);
+    p += 8;
+  }
+
+  while (p < end && ccursor_is_digit(*p)) {
+    num = num * 10 + (uint64_t)(*p - '0');
+    p++;
+  }
+
+  *value = num;
+  return p;
+}
+
+/**
+ * @brief Convert char HEX character into a nibble
+ *
+ * @param[out] nibble - parsed nibble value
+ * @param[in]  c      - character to parse
+ * @return true on success, else false
+ */
+static inline bool ccursor_hex_char_to_nibble(uint8_t *nibble,
+                                              const char c) {
+  if (c >= '0' && c <= '9') {
+    *nibble = (c - '0');
+    return true;
+  } else if (c >= 'a' && c <= 'f') {
+    *nibble = (c - 'a' + 10);
+    return true;
+  } else if (c >= 'A' && c <= 'F') {
+    *nibble = (c - 'A' + 10);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+/**
+ * @brief Parses up to 8 hex digits with an optional leading "0x"
+ *
+ * Mirrors the syntax of ccursor_read_u32_be: leading spaces, an optional
+ * "0x" prefix and at least one hex digit. Never reads at or beyond end.
+ *
+ * @param[in]  p     - first character to parse
+ * @param[in]  end   - end of the readable area
+ * @param[out] value - parsed value
+ * @return pointer behind the number on success, else NULL
+ */
+static inline const char *ccursor_parse_hex(const char *p, const char *end,
+                                            uint32_t *value) {
+  while (p < end && *p == ' ') {
+    p++;
+  }
+  if (end - p >= 2 && p[0] == '0' && p[1] == 'x') {
+    p += 2;
+  }
+
+  uint32_t num = 0;
+  uint8_t nibble = 0;
+  const char *const digits = p;
+  while (p < end && (p - digits) < (ptrdiff_t)(sizeof(uint32_t) * 2) &&
+         ccursor_hex_char_to_nibble(&nibble, *p)) {
+    num = num << 4 | nibble;
+    p++;
+  }
+
+  if (p == digits) {
+    return NULL;
+  }
+
+  *value = num;
+  return p;
+}
+
+/**
+ * @brief Parses an optionally signed decimal integer magnitude
+ *
+ * Mirrors the strtol syntax for base 10: leading whitespace, an optional
+ * sign and at least one digit. Never reads at or beyond end.
+ *
+ * @param[in]  p         - first character to parse
+ * @param[in]  end       - end of the readable area
+ * @param[out] negative  - true if a minus sign was found
+ * @param[out] magnitude - absolute value of the parsed integer
+ * @return pointer behind the number on success, NULL if there are no digits
+ *         or the magnitude does not fit into an uint64_t
+ */
+static inline const char *ccursor_parse_integer(const char *p,
+                                                const char *end,
+                                                bool *negative,
+                                                uint64_t *magnitude) {
+  while (p < end && ccursor_is_space(*p)) {
+    p++;
+  }
+
+  *negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    *negative = (*p == '-');
+    p++;
+  }
+
+  const char *digits = p;
+  while (p < end && *p == '0') {
+    p++;
+  }
+  const char *significant = p;
+
+  uint64_t num = 0;
+  p = ccursor_accumulate_digits(p, end, &num);
+  if (p == digits) {
+    return NULL;
+  }
+
+  // up to 19 digits always fit, the 20th one has to be checked
+  ptrdiff_t count = p - significant;
+  if (count > 20) {
+    return NULL;
+  } else if (count == 20) {
+    num = 0;
+    ccursor_accumulate_digits(significant, significant + 19, &num);
+    uint64_t last = (uint64_t)(significant[19] - '0');
+    if (num > (_UINT64_MAX - last) / 10) {
+      return NULL;
+    }
+    num = num * 10 + last;
+  }
+
+  *magnitude = num;
+  return p;
+}
+
+// largest scale of a fixed-point decimal which fits into an uint64_t
+#define CCURSOR_DECIMAL_MAX_SCALE 18
+
+/**
+ * @brief Powers of ten which fit into an uint64_t, indexed by the exponent
+ */
+static const uint64_t ccursor_powers_of_ten[] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+};
+
+/**
+ * @brief Parses a fixed-point decimal into an integer scaled by 10^scale
+ *
+ * Accepts leading whitespace, an optional sign and digits with an optional
+ * fraction, see ccursor_read_decimal. Never reads at or beyond end.
+ *
+ * @param[in]  p     - first character to parse
+ * @param[in]  end   - end of the readable area
+ * @param[in]  scale - number of fraction digits to keep, at most
+ *                     CCURSOR_DECIMAL_MAX_SCALE
+ * @param[in]  mode  - handling of surplus fraction digits
+ * @param[out] value - parsed value scaled by 10^scale
+ * @return pointer behind the number on success, NULL if there are no digits
+ *         or the scaled value does not fit into an int64_t
+ */
+static inline const char *ccursor_parse_decimal(const char *p,
+                                                const char *end,
+                                                uint8_t scale,
+                                                ccursor_decimal_mode_t mode,
+                                                int64_t *value) {
+  while (p < end && ccursor_is_space(*p)) {
+    p++;
+  }
+
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    p++;
+  }
+
+  // integer part, a missing one is allowed if a fraction follows
+  uint64_t integer = 0;
+  bool has_integer = (p < end && ccursor_is_digit(*p));
+  if (has_integer) {
+    bool unsigned_sign = false;
+    p = ccursor_parse_integer(p, end, &unsigned_sign, &integer);
+    if (p == NULL) {
+      return NULL;
+    }
+  }
+
+  // fraction part, digits beyond the scale only decide the rounding
+  uint64_t fraction = 0;
+  uint8_t fraction_digits = 0;
+  bool round_up = false;
+  if (p + 1 < end && *p == '.' && ccursor_is_digit(*(p + 1))) {
+    p++;
+    const char *fraction_end = p;
+    while (fraction_end < end && ccursor_is_digit(*fraction_end)) {
+      fraction_end++;
+    }
+    const char *taken_end =
+        (fraction_end - p > scale) ? p + scale : fraction_end;
+    fraction_digits = (uint8_t)(taken_end - p);
+    p = ccursor_accumulate_digits(p, taken_end, &fraction);
+    if (mode == E_CCURSOR_DECIMAL_ROUND && p < fraction_end) {
+      round_up = (*p >= '5');
+    }
+    p = fraction_end;
+  } else if (!has_integer) {
+    return NULL;
+  }
+
+  // combine integer and fraction part, the limit includes the sign
+  const uint64_t limit = negative ? (uint64_t)_INT64_MAX + 1 : _INT64_MAX;
+  const uint64_t multiplier = ccursor_powers_of_ten[scale];
+  if (integer > limit / multiplier) {
+    return NULL;
+  }
+  uint64_t num = integer * multiplier;
+  fraction *= ccursor_powers_of_ten[scale - fraction_digits];
+  if (fraction > limit - num) {
+    return NULL;
+  }
+  num += fraction;
+  if (round_up) {
+    if (num == limit) {
+      return NULL;
+    }
+    num++;
+  }
+
+  *value = negative ? (int64_t)(0 - num) : (int64_t)num;
+  return p;
+}
+
+
+#endif // CCURSOR_INTERNAL_H
@@ -0,0 +1,315 @@
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
+
+#include "ccursor_iovec.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Points the segment handle at the start of a segment
+ *
+ * @param[in,out] cursor - iovec cursor
+ * @param[in]     index  - index of the segment
+ */
+static void ccursor_iovec_load(ccursor_iovec_t *cursor, size_t index) {
+  cursor->index = index;
+  cursor->segment.buffer = cursor->segments[index].iov_base;
+  cursor->segment.buffer_size = (uint32_t)cursor->segments[index].iov_len;
+  cursor->segment.read_position = cursor->segment.buffer;
+}
+
+/**
+ * @brief Moves on to the next segment which is not empty
+ *
+ * @param[in,out] cursor - iovec cursor
+ * @return true if a character is available, false if all are consumed
+ */
+static bool ccursor_iovec_normalize(ccursor_iovec_t *cursor) {
+  ccursor_handle_t *segment = &cursor->segment;
+  while (segment->read_position >= CCURSOR_END(segment)) {
+    if (cursor->index + 1 >= cursor->count) {
+      return false;
+    }
+    ccursor_iovec_load(cursor, cursor->index + 1);
+  }
+  return true;
+}
+
+/**
+ * @brief Checks if any segment behind the current one holds characters
+ *
+ * @param[in] cursor - iovec cursor
+ * @return true if more characters follow the current segment, else false
+ */
+static bool ccursor_iovec_continues(const ccursor_iovec_t *cursor) {
+  for (size_t idx = cursor->index + 1; idx < cursor->count; idx++) {
+    if (cursor->segments[idx].iov_len > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Advances the cursor by a number of characters
+ *
+ * @param[in,out] cursor - iovec cursor
+ * @param[in]     size   - number of characters, at most the available ones
+ */
+static void ccursor_iovec_advance(ccursor_iovec_t *cursor, size_t size) {
+  while (size > 0 && ccursor_iovec_normalize(cursor)) {
+    ccursor_handle_t *segment = &cursor->segment;
+    size_t remaining = (size_t)CCURSOR_REMAINING_SIZE(segment);
+    size_t step = (size < remaining) ? size : remaining;
+    segment->read_position += step;
+    size -= step;
+  }
+}
+
+/**
+ * @brief Copies the next characters into the carry buffer
+ *
+ * @param[in,out] cursor    - iovec cursor, its position is not changed
+ * @param[out]    truncated - true if more characters follow the copied ones
+ * @return number of copied characters, at most 2 * CCURSOR_IOVEC_CARRY
+ */
+static size_t ccursor_iovec_fill(ccursor_iovec_t *cursor, bool *truncated) {
+  size_t size = 0;
+  const char *p = cursor->segment.read_position;
+  const char *end = CCURSOR_END((&cursor->segment));
+  size_t index = cursor->index;
+
+  while (true) {
+    size_t step = (size_t)(end - p);
+    if (step > 2 * CCURSOR_IOVEC_CARRY - size) {
+      step = 2 * CCURSOR_IOVEC_CARRY - size;
+    }
+    if (step > 0) {
+      memcpy(cursor->carry + size, p, step);
+      size += step;
+      p += step;
+    }
+
+    // stop at the first character which does not fit anymore
+    if (p < end || ++index >= cursor->count) {
+      break;
+    }
+    p = cursor->segments[index].iov_base;
+    end = p + cursor->segments[index].iov_len;
+  }
+
+  cursor->carry[size] = '\0';
+  *truncated = (p < end);
+  return size;
+}
+
+ccursor_ret_t ccursor_iovec_init(ccursor_iovec_t *cursor,
+                                 const struct iovec *segments, size_t count) {
+  if (cursor == NULL || segments == NULL || count == 0) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  for (size_t idx = 0; idx < count; idx++) {
+    if (segments[idx].iov_len > _UINT32_MAX ||
+        (segments[idx].iov_base == NULL && segments[idx].iov_len > 0)) {
+      return E_CCURSOR_ERR_PARAM;
+    }
+  }
+
+  cursor->segments = segments;
+  cursor->count = count;
+  ccursor_iovec_load(cursor, 0);
+  return E_CCURSOR_OK;
+}
+
+size_t ccursor_iovec_available(const ccursor_iovec_t *cursor) {
+  if (cursor == NULL) {
+    return 0;
+  }
+
+  size_t available = (size_t)CCURSOR_REMAINING_SIZE((&cursor->segment));
+  for (size_t idx = cursor->index + 1; idx < cursor->count; idx++) {
+    available += cursor->segments[idx].iov_len;
+  }
+  return available;
+}
+
+size_t ccursor_iovec_position(const ccursor_iovec_t *cursor) {
+  if (cursor == NULL) {
+    return 0;
+  }
+
+  size_t position = (size_t)(cursor->segment.read_position -
+                             cursor->segment.buffer);
+  for (size_t idx = 0; idx < cursor->index; idx++) {
+    position += cursor->segments[idx].iov_len;
+  }
+  return position;
+}
+
+ccursor_ret_t ccursor_iovec_read(ccursor_iovec_t *cursor,
+                                 ccursor_iovec_reader_t reader, void *value,
+                                 size_t size) {
+  if (cursor == NULL || reader == NULL || value == NULL || size == 0 ||
+      size > CCURSOR_IOVEC_VALUE || !ccursor_iovec_normalize(cursor)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  // the reader fills a copy, a rejected token leaves the value unchanged
+  _Alignas(max_align_t) char parsed[CCURSOR_IOVEC_VALUE];
+
+  // most tokens end within the segment and are parsed in place
+  ccursor_handle_t *segment = &cursor->segment;
+  char *const read_position_pre = segment->read_position;
+  size_t remaining = (size_t)CCURSOR_REMAINING_SIZE(segment);
+  ccursor_ret_t ret = reader(segment, parsed);
+  size_t tail = (size_t)CCURSOR_REMAINING_SIZE(segment);
+
+  // a reader may also stop shortly before the end of the segment on a token
+  // which continues in the next one, e.g. a float split within its exponent
+  bool boundary = (ret != E_CCURSOR_OK || tail < CCURSOR_IOVEC_CARRY);
+  if (!boundary || !ccursor_iovec_continues(cursor)) {
+    if (ret == E_CCURSOR_OK) {
+      memcpy(value, parsed, size);
+    }
+    return ret;
+  }
+
+  segment->read_position = read_position_pre;
+  if (remaining >= 2 * CCURSOR_IOVEC_CARRY) {
+    // the token is longer than CCURSOR_IOVEC_CARRY and does not fit the carry
+    return (ret == E_CCURSOR_OK) ? E_CCURSOR_ERR_PARSE : ret;
+  }
+
+  // the token may continue in the next segment, parse it from the carry
+  bool truncated = false;
+  size_t carried_size = ccursor_iovec_fill(cursor, &truncated);
+  ccursor_handle_t carried = {
+      .buffer = cursor->carry,
+      .buffer_size = (uint32_t)carried_size,
+      .read_position = cursor->carry,
+  };
+  ret = reader(&carried, parsed);
+  if (ret != E_CCURSOR_OK) {
+    return ret;
+  }
+
+  size_t consumed = (size_t)(carried.read_position - carried.buffer);
+  if (consumed == carried_size && truncated) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+  memcpy(value, parsed, size);
+  ccursor_iovec_advance(cursor, consumed);
+  return E_CCURSOR_OK;
+}
+
+static ccursor_ret_t ccursor_iovec_u32_reader(ccursor_handle_t *handle,
+                                              void *value) {
+  return ccursor_read_u32(handle, value);
+}
+
+static ccursor_ret_t ccursor_iovec_i32_reader(ccursor_handle_t *handle,
+                                              void *value) {
+  return ccursor_read_i32(handle, value);
+}
+
+static ccursor_ret_t ccursor_iovec_f64_reader(ccursor_handle_t *handle,
+                                              void *value) {
+  return ccursor_read_f64(handle, value);
+}
+
+ccursor_ret_t ccursor_iovec_read_u32(ccursor_iovec_t *cursor,
+                                     uint32_t *value) {
+  return ccursor_iovec_read(cursor, ccursor_iovec_u32_reader, value,
+                            sizeof(*value));
+}
+
+ccursor_ret_t ccursor_iovec_read_i32(ccursor_iovec_t *cursor, int32_t *value) {
+  return ccursor_iovec_read(cursor, ccursor_iovec_i32_reader, value,
+                            sizeof(*value));
+}
+
+ccursor_ret_t ccursor_iovec_read_f64(ccursor_iovec_t *cursor, double *value) {
+  return ccursor_iovec_read(cursor, ccursor_iovec_f64_reader, value,
+                            sizeof(*value));
+}
+
+ccursor_ret_t ccursor_iovec_read_char(ccursor_iovec_t *cursor, char *c) {
+  if (cursor == NULL || c == NULL || !ccursor_iovec_normalize(cursor)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  *c = *cursor->segment.read_position++;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_iovec_skip_char(ccursor_iovec_t *cursor, char c) {
+  if (cursor == NULL || !ccursor_iovec_normalize(cursor)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  if (*cursor->segment.read_position != c) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  cursor->segment.read_position++;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_iovec_skip_substr(ccursor_iovec_t *cursor,
+                                        const char *substr) {
+  if (cursor == NULL || substr == NULL || !ccursor_iovec_normalize(cursor)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const size_t index_pre = cursor->index;
+  char *const read_position_pre = cursor->segment.read_position;
+
+  // compare segment by segment, a mismatch restores the position
+  const char *s = substr;
+  while (*s != '\0') {
+    if (!ccursor_iovec_normalize(cursor)) {
+      break;
+    }
+    ccursor_handle_t *segment = &cursor->segment;
+    size_t length = strnlen(s, (size_t)CCURSOR_REMAINING_SIZE(segment));
+    if (memcmp(segment->read_position, s, length) != 0) {
+      break;
+    }
+    segment->read_position += length;
+    s += length;
+  }
+
+  if (*s != '\0') {
+    ccursor_iovec_load(cursor, index_pre);
+    cursor->segment.read_position = read_position_pre;
+    return E_CCURSOR_ERR_PARSE;
+  }
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_iovec_skip_until_char(ccursor_iovec_t *cursor,
+                                            uint8_t c) {
+  if (cursor == NULL || !ccursor_iovec_normalize(cursor)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const size_t index_pre = cursor->index;
+  char *const read_position_pre = cursor->segment.read_position;
+
+  while (ccursor_iovec_normalize(cursor)) {
+    ccursor_handle_t *segment = &cursor->segment;
+    const char *found = ccursor_kernels->find_char(
+        segment->read_position, CCURSOR_END(segment), (char)c);
+    segment->read_position = (char *)found;
+    if (found != CCURSOR_END(segment)) {
+      // also skip the found character
+      segment->read_position++;
+      return E_CCURSOR_OK;
+    }
+  }
+
+  ccursor_iovec_load(cursor, index_pre);
+  cursor->segment.read_position = read_position_pre;
+  return E_CCURSOR_ERR_PARSE;
+}
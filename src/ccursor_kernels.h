@@ -0,0 +1,101 @@
+#ifndef CCURSOR_KERNELS_H
+#define CCURSOR_KERNELS_H
+
+#include "ccursor_internal.h"
+
+/**
+ * @brief Scanning and number kernels of a single instruction set
+ *
+ * None of the kernels accesses memory at or beyond the given end. Kernels
+ * working on blocks only process whole blocks and report how far they got,
+ * the remainder is left to the scalar code of the caller.
+ */
+typedef struct {
+  /** Name of the instruction set, as reported by ccursor_active_isa */
+  const char *isa;
+
+  /** Returns the first occurrence of c in [begin, end) or end */
+  const char *(*find_char)(const char *begin, const char *end, char c);
+
+  /** Returns the last occurrence of c in [begin, end) or end */
+  const char *(*rfind_char)(const char *begin, const char *end, char c);
+
+  /** Returns the number of occurrences of c in [begin, end) */
+  size_t (*count_char)(const char *begin, const char *end, char c);
+
+  /** Returns a mask of the 64 characters at block which equal a or b */
+  uint64_t (*match_mask)(const char *block, char a, char b);
+
+  /** Returns the first character in [begin, end) whose membership in set
+   *  differs from member, or end */
+  const char *(*span)(const char *begin, const char *end,
+                      const ccursor_charset_t *set, bool member);
+
+  /** Returns the position behind the last character in [begin, end) whose
+   *  membership in set differs from member, or begin */
+  const char *(*rspan)(const char *begin, const char *end,
+                       const ccursor_charset_t *set, bool member);
+
+  /** Copies count values from bytes and swaps the byte order of each */
+  void (*swap_array16)(uint16_t *values, const char *bytes, size_t count);
+  void (*swap_array32)(uint32_t *values, const char *bytes, size_t count);
+  void (*swap_array64)(uint64_t *values, const char *bytes, size_t count);
+
+  /**
+   * Decodes up to count 32-bit varints block by block. Returns the position
+   * behind the last decoded varint and its number in decoded, or NULL if an
+   * invalid varint was found.
+   */
+  const char *(*decode_varints32)(const char *p, const char *end,
+                                  uint32_t *values, size_t count,
+                                  size_t *decoded);
+
+  /**
+   * Converts up to max runs of 1 to 8 digits which are terminated by sep.
+   * Advances p behind the separator of the last converted run and points
+   * last_end to the end of that run. Returns the number of converted runs.
+   */
+  size_t (*convert_list_block)(const char **p, const char *end, char sep,
+                               uint32_t *values, size_t max,
+                               const char **last_end);
+} ccursor_kernels_t;
+
+/**
+ * @brief Kernel table selected once at load time, see ccursor_dispatch.c
+ */
+extern const ccursor_kernels_t *ccursor_kernels;
+
+// portable baseline, always available
+extern const ccursor_kernels_t ccursor_kernels_scalar;
+const char *ccursor_scalar_find_char(const char *begin, const char *end,
+                                     char c);
+const char *ccursor_scalar_rfind_char(const char *begin, const char *end,
+                                      char c);
+size_t ccursor_scalar_count_char(const char *begin, const char *end, char c);
+uint64_t ccursor_scalar_match_mask(const char *block, char a, char b);
+const char *ccursor_scalar_span(const char *begin, const char *end,
+                                const ccursor_charset_t *set, bool member);
+const char *ccursor_scalar_rspan(const char *begin, const char *end,
+                                 const ccursor_charset_t *set, bool member);
+void ccursor_scalar_swap_array16(uint16_t *values, const char *bytes,
+                                 size_t count);
+void ccursor_scalar_swap_array32(uint32_t *values, const char *bytes,
+                                 size_t count);
+void ccursor_scalar_swap_array64(uint64_t *values, const char *bytes,
+                                 size_t count);
+
+#if defined(CCURSOR_X86_KERNELS)
+extern const ccursor_kernels_t ccursor_kernels_sse2;
+extern const ccursor_kernels_t ccursor_kernels_avx2;
+extern const ccursor_kernels_t ccursor_kernels_avx512;
+
+// SSE2 kernels reused by the wider instruction sets
+const char *ccursor_sse2_decode_varints32(const char *p, const char *end,
+                                          uint32_t *values, size_t count,
+                                          size_t *decoded);
+size_t ccursor_sse2_convert_list_block(const char **p, const char *end,
+                                       char sep, uint32_t *values, size_t max,
+                                       const char **last_end);
+#endif
+
+#endif // CCURSOR_KERNELS_H
@@ -0,0 +1,202 @@
+#include "ccursor_kernels.h"
+
+#include <immintrin.h>
+
+static const char *ccursor_avx2_find_char(const char *begin, const char *end,
+                                          char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  while (end - begin >= 32) {
+    __m256i block = _mm256_loadu_si256((const __m256i *)begin);
+    uint32_t mask =
+        (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return begin + _ctz32(mask);
+    }
+    begin += 32;
+  }
+  return ccursor_scalar_find_char(begin, end, c);
+}
+
+/**
+ * @brief Searches blocks from the end, the head is left to the scalar code
+ */
+static const char *ccursor_avx2_rfind_char(const char *begin, const char *end,
+                                           char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  const char *p = end;
+  while (p - begin >= 32) {
+    __m256i block = _mm256_loadu_si256((const __m256i *)(p - 32));
+    uint32_t mask =
+        (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return p - 1 - _clz32(mask);
+    }
+    p -= 32;
+  }
+  const char *found = ccursor_scalar_rfind_char(begin, p, c);
+  return (found != p) ? found : end;
+}
+
+/**
+ * @brief Counts matches in byte counters, which are summed up before they
+ *        can overflow after 255 blocks
+ */
+static size_t ccursor_avx2_count_char(const char *begin, const char *end,
+                                      char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  size_t count = 0;
+
+  while (end - begin >= 32) {
+    size_t blocks = (size_t)(end - begin) / 32;
+    const char *stop = begin + 32 * (blocks < 255 ? blocks : 255);
+    __m256i counters = _mm256_setzero_si256();
+    for (; begin < stop; begin += 32) {
+      __m256i block = _mm256_loadu_si256((const __m256i *)begin);
+      counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(block, needle));
+    }
+    __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+    count += (size_t)_mm256_extract_epi32(sums, 0) +
+             (size_t)_mm256_extract_epi32(sums, 2) +
+             (size_t)_mm256_extract_epi32(sums, 4) +
+             (size_t)_mm256_extract_epi32(sums, 6);
+  }
+
+  return count + ccursor_scalar_count_char(begin, end, c);
+}
+
+static uint64_t ccursor_avx2_match_mask(const char *block, char a, char b) {
+  const __m256i first = _mm256_set1_epi8(a);
+  const __m256i second = _mm256_set1_epi8(b);
+  __m256i low = _mm256_loadu_si256((const __m256i *)block);
+  __m256i high = _mm256_loadu_si256((const __m256i *)(block + 32));
+  low = _mm256_or_si256(_mm256_cmpeq_epi8(low, first),
+                        _mm256_cmpeq_epi8(low, second));
+  high = _mm256_or_si256(_mm256_cmpeq_epi8(high, first),
+                         _mm256_cmpeq_epi8(high, second));
+  return (uint64_t)(uint32_t)_mm256_movemask_epi8(low) |
+         (uint64_t)(uint32_t)_mm256_movemask_epi8(high) << 32;
+}
+
+/**
+ * @brief Classifies 32 characters at once with the nibble tables of a set
+ *
+ * @param[in] block  - the characters
+ * @param[in] low    - groups of the low nibbles in both lanes
+ * @param[in] high   - groups of the high nibbles in both lanes
+ * @param[in] invert - 0 to stop at non-members, all ones to stop at members
+ * @return mask of the characters to stop at
+ */
+static inline uint32_t ccursor_avx2_classify(const char *block, __m256i low,
+                                             __m256i high, uint32_t invert) {
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  __m256i v = _mm256_loadu_si256((const __m256i *)block);
+  __m256i groups = _mm256_and_si256(
+      _mm256_shuffle_epi8(low, _mm256_and_si256(v, nibble)),
+      _mm256_shuffle_epi8(high,
+                          _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble)));
+  return (uint32_t)_mm256_movemask_epi8(
+             _mm256_cmpeq_epi8(groups, _mm256_setzero_si256())) ^
+         invert;
+}
+
+static const char *ccursor_avx2_span(const char *begin, const char *end,
+                                     const ccursor_charset_t *set,
+                                     bool member) {
+  if (set->nibbles) {
+    const __m256i low = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)set->low));
+    const __m256i high = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)set->high));
+    const uint32_t invert = member ? 0 : 0xFFFFFFFF;
+    while (end - begin >= 32) {
+      uint32_t stop = ccursor_avx2_classify(begin, low, high, invert);
+      if (stop != 0) {
+        return begin + _ctz32(stop);
+      }
+      begin += 32;
+    }
+  }
+  return ccursor_scalar_span(begin, end, set, member);
+}
+
+static const char *ccursor_avx2_rspan(const char *begin, const char *end,
+                                      const ccursor_charset_t *set,
+                                      bool member) {
+  if (set->nibbles) {
+    const __m256i low = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)set->low));
+    const __m256i high = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)set->high));
+    const uint32_t invert = member ? 0 : 0xFFFFFFFF;
+    while (end - begin >= 32) {
+      uint32_t stop = ccursor_avx2_classify(end - 32, low, high, invert);
+      if (stop != 0) {
+        return end - _clz32(stop);
+      }
+      end -= 32;
+    }
+  }
+  return ccursor_scalar_rspan(begin, end, set, member);
+}
+
+/**
+ * @brief Swaps the bytes of each element with a single in-lane shuffle
+ *
+ * @param[in] shuffle - byte order of a 16 byte lane after the swap
+ */
+static inline void ccursor_avx2_swap_blocks(char *values, const char *bytes,
+                                            size_t size, __m128i shuffle) {
+  const __m256i order = _mm256_broadcastsi128_si256(shuffle);
+  for (size_t idx = 0; idx + 32 <= size; idx += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(bytes + idx));
+    _mm256_storeu_si256((__m256i *)(values + idx),
+                        _mm256_shuffle_epi8(v, order));
+  }
+}
+
+static void ccursor_avx2_swap_array16(uint16_t *values, const char *bytes,
+                                      size_t count) {
+  size_t blocks = count / 16 * 16;
+  ccursor_avx2_swap_blocks((char *)values, bytes, blocks * 2,
+                           _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+                                         10, 13, 12, 15, 14));
+  ccursor_scalar_swap_array16(values + blocks, bytes + blocks * 2,
+                              count - blocks);
+}
+
+static void ccursor_avx2_swap_array32(uint32_t *values, const char *bytes,
+                                      size_t count) {
+  size_t blocks = count / 8 * 8;
+  ccursor_avx2_swap_blocks((char *)values, bytes, blocks * 4,
+                           _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9,
+                                         8, 15, 14, 13, 12));
+  ccursor_scalar_swap_array32(values + blocks, bytes + blocks * 4,
+                              count - blocks);
+}
+
+static void ccursor_avx2_swap_array64(uint64_t *values, const char *bytes,
+                                      size_t count) {
+  size_t blocks = count / 4 * 4;
+  ccursor_avx2_swap_blocks((char *)values, bytes, blocks * 8,
+                           _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13,
+                                         12, 11, 10, 9, 8));
+  ccursor_scalar_swap_array64(values + blocks, bytes + blocks * 8,
+                              count - blocks);
+}
+
+// the number kernels are bound by the per-element extraction, not the
+// classification width, so the SSE2 versions are reused
+const ccursor_kernels_t ccursor_kernels_avx2 = {
+    .isa = "avx2",
+    .find_char = ccursor_avx2_find_char,
+    .rfind_char = ccursor_avx2_rfind_char,
+    .count_char = ccursor_avx2_count_char,
+    .match_mask = ccursor_avx2_match_mask,
+    .span = ccursor_avx2_span,
+    .rspan = ccursor_avx2_rspan,
+    .swap_array16 = ccursor_avx2_swap_array16,
+    .swap_array32 = ccursor_avx2_swap_array32,
+    .swap_array64 = ccursor_avx2_swap_array64,
+    .decode_varints32 = ccursor_sse2_decode_varints32,
+    .convert_list_block = ccursor_sse2_convert_list_block,
+};
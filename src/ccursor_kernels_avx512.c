@@ -0,0 +1,202 @@
+#include "ccursor_kernels.h"
+
+#include <immintrin.h>
+
+static const char *ccursor_avx512_find_char(const char *begin,
+                                            const char *end, char c) {
+  const __m512i needle = _mm512_set1_epi8(c);
+  while (end - begin >= 64) {
+    __m512i block = _mm512_loadu_si512((const void *)begin);
+    uint64_t mask = _mm512_cmpeq_epi8_mask(block, needle);
+    if (mask != 0) {
+      return begin + _ctz64(mask);
+    }
+    begin += 64;
+  }
+
+  // the tail is compared with a masked load, which does not fault beyond end
+  if (begin < end) {
+    __mmask64 valid = (1ULL << (end - begin)) - 1;
+    __m512i block = _mm512_maskz_loadu_epi8(valid, (const void *)begin);
+    uint64_t mask = _mm512_mask_cmpeq_epi8_mask(valid, block, needle);
+    return (mask != 0) ? begin + _ctz64(mask) : end;
+  }
+  return end;
+}
+
+static const char *ccursor_avx512_rfind_char(const char *begin,
+                                             const char *end, char c) {
+  const __m512i needle = _mm512_set1_epi8(c);
+  const char *p = end;
+  while (p - begin >= 64) {
+    __m512i block = _mm512_loadu_si512((const void *)(p - 64));
+    uint64_t mask = _mm512_cmpeq_epi8_mask(block, needle);
+    if (mask != 0) {
+      return p - 1 - _clz64(mask);
+    }
+    p -= 64;
+  }
+
+  // the head is compared with a masked load, which does not fault
+  if (begin < p) {
+    __mmask64 valid = (1ULL << (p - begin)) - 1;
+    __m512i block = _mm512_maskz_loadu_epi8(valid, (const void *)begin);
+    uint64_t mask = _mm512_mask_cmpeq_epi8_mask(valid, block, needle);
+    return (mask != 0) ? begin + 63 - _clz64(mask) : end;
+  }
+  return end;
+}
+
+static size_t ccursor_avx512_count_char(const char *begin, const char *end,
+                                        char c) {
+  const __m512i needle = _mm512_set1_epi8(c);
+  size_t count = 0;
+  while (end - begin >= 64) {
+    __m512i block = _mm512_loadu_si512((const void *)begin);
+    count += (size_t)_popcount64(_mm512_cmpeq_epi8_mask(block, needle));
+    begin += 64;
+  }
+  return count + ccursor_scalar_count_char(begin, end, c);
+}
+
+static uint64_t ccursor_avx512_match_mask(const char *block, char a,
+                                          char b) {
+  __m512i v = _mm512_loadu_si512((const void *)block);
+  return _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(a)) |
+         _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(b));
+}
+
+/**
+ * @brief Classifies up to 64 characters at once with the nibble tables of a
+ *        set, the characters outside valid are neither loaded nor reported
+ *
+ * @param[in] block  - the characters
+ * @param[in] valid  - mask of the characters to classify
+ * @param[in] low    - groups of the low nibbles in all lanes
+ * @param[in] high   - groups of the high nibbles in all lanes
+ * @param[in] invert - 0 to stop at non-members, all ones to stop at members
+ * @return mask of the characters to stop at
+ */
+static inline uint64_t ccursor_avx512_classify(const char *block,
+                                               __mmask64 valid, __m512i low,
+                                               __m512i high, uint64_t invert) {
+  const __m512i nibble = _mm512_set1_epi8(0x0F);
+  __m512i v = _mm512_maskz_loadu_epi8(valid, (const void *)block);
+  __m512i groups = _mm512_and_si512(
+      _mm512_shuffle_epi8(low, _mm512_and_si512(v, nibble)),
+      _mm512_shuffle_epi8(high,
+                          _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble)));
+  return (_mm512_testn_epi8_mask(groups, groups) ^ invert) & valid;
+}
+
+static const char *ccursor_avx512_span(const char *begin, const char *end,
+                                       const ccursor_charset_t *set,
+                                       bool member) {
+  if (!set->nibbles) {
+    return ccursor_scalar_span(begin, end, set, member);
+  }
+
+  const __m512i low =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)set->low));
+  const __m512i high =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)set->high));
+  const uint64_t invert = member ? 0 : ~0ULL;
+  while (begin < end) {
+    __mmask64 valid =
+        (end - begin >= 64) ? ~0ULL : (1ULL << (end - begin)) - 1;
+    uint64_t stop = ccursor_avx512_classify(begin, valid, low, high, invert);
+    if (stop != 0) {
+      return begin + _ctz64(stop);
+    }
+    begin += _popcount64(valid);
+  }
+  return end;
+}
+
+static const char *ccursor_avx512_rspan(const char *begin, const char *end,
+                                        const ccursor_charset_t *set,
+                                        bool member) {
+  if (!set->nibbles) {
+    return ccursor_scalar_rspan(begin, end, set, member);
+  }
+
+  const __m512i low =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)set->low));
+  const __m512i high =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)set->high));
+  const uint64_t invert = member ? 0 : ~0ULL;
+  while (end - begin >= 64) {
+    uint64_t stop = ccursor_avx512_classify(end - 64, ~0ULL, low, high, invert);
+    if (stop != 0) {
+      return end - _clz64(stop);
+    }
+    end -= 64;
+  }
+
+  // the head is classified with a masked load, which does not fault
+  if (begin < end) {
+    __mmask64 valid = (1ULL << (end - begin)) - 1;
+    uint64_t stop = ccursor_avx512_classify(begin, valid, low, high, invert);
+    return (stop != 0) ? begin + 64 - _clz64(stop) : begin;
+  }
+  return begin;
+}
+
+/**
+ * @brief Swaps the bytes of each element with a single in-lane shuffle
+ *
+ * @param[in] shuffle - byte order of a 16 byte lane after the swap
+ */
+static inline void ccursor_avx512_swap_blocks(char *values, const char *bytes,
+                                              size_t size, __m128i shuffle) {
+  const __m512i order = _mm512_broadcast_i32x4(shuffle);
+  for (size_t idx = 0; idx + 64 <= size; idx += 64) {
+    __m512i v = _mm512_loadu_si512((const void *)(bytes + idx));
+    _mm512_storeu_si512((void *)(values + idx), _mm512_shuffle_epi8(v, order));
+  }
+}
+
+static void ccursor_avx512_swap_array16(uint16_t *values, const char *bytes,
+                                        size_t count) {
+  size_t blocks = count / 32 * 32;
+  ccursor_avx512_swap_blocks((char *)values, bytes, blocks * 2,
+                             _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+                                           10, 13, 12, 15, 14));
+  ccursor_scalar_swap_array16(values + blocks, bytes + blocks * 2,
+                              count - blocks);
+}
+
+static void ccursor_avx512_swap_array32(uint32_t *values, const char *bytes,
+                                        size_t count) {
+  size_t blocks = count / 16 * 16;
+  ccursor_avx512_swap_blocks((char *)values, bytes, blocks * 4,
+                             _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9,
+                                           8, 15, 14, 13, 12));
+  ccursor_scalar_swap_array32(values + blocks, bytes + blocks * 4,
+                              count - blocks);
+}
+
+static void ccursor_avx512_swap_array64(uint64_t *values, const char *bytes,
+                                        size_t count) {
+  size_t blocks = count / 8 * 8;
+  ccursor_avx512_swap_blocks((char *)values, bytes, blocks * 8,
+                             _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13,
+                                           12, 11, 10, 9, 8));
+  ccursor_scalar_swap_array64(values + blocks, bytes + blocks * 8,
+                              count - blocks);
+}
+
+const ccursor_kernels_t ccursor_kernels_avx512 = {
+    .isa = "avx512",
+    .find_char = ccursor_avx512_find_char,
+    .rfind_char = ccursor_avx512_rfind_char,
+    .count_char = ccursor_avx512_count_char,
+    .match_mask = ccursor_avx512_match_mask,
+    .span = ccursor_avx512_span,
+    .rspan = ccursor_avx512_rspan,
+    .swap_array16 = ccursor_avx512_swap_array16,
+    .swap_array32 = ccursor_avx512_swap_array32,
+    .swap_array64 = ccursor_avx512_swap_array64,
+    .decode_varints32 = ccursor_sse2_decode_varints32,
+    .convert_list_block = ccursor_sse2_convert_list_block,
+};
@@ -0,0 +1,131 @@
+#include "ccursor_kernels.h"
+
+const char *ccursor_scalar_find_char(const char *begin, const char *end,
+                                     char c) {
+  while (begin < end && *begin != c) {
+    begin++;
+  }
+  return begin;
+}
+
+const char *ccursor_scalar_rfind_char(const char *begin, const char *end,
+                                      char c) {
+  for (const char *p = end; p > begin; p--) {
+    if (p[-1] == c) {
+      return p - 1;
+    }
+  }
+  return end;
+}
+
+size_t ccursor_scalar_count_char(const char *begin, const char *end,
+                                 char c) {
+  size_t count = 0;
+  for (; begin < end; begin++) {
+    count += (*begin == c);
+  }
+  return count;
+}
+
+uint64_t ccursor_scalar_match_mask(const char *block, char a, char b) {
+  uint64_t mask = 0;
+  for (uint32_t idx = 0; idx < 64; idx++) {
+    mask |= (uint64_t)(block[idx] == a || block[idx] == b) << idx;
+  }
+  return mask;
+}
+
+const char *ccursor_scalar_span(const char *begin, const char *end,
+                                const ccursor_charset_t *set, bool member) {
+  for (; begin < end; begin++) {
+    uint8_t c = (uint8_t)*begin;
+    if (((set->bits[c / 64] >> (c % 64)) & 1) != member) {
+      break;
+    }
+  }
+  return begin;
+}
+
+const char *ccursor_scalar_rspan(const char *begin, const char *end,
+                                 const ccursor_charset_t *set, bool member) {
+  for (; end > begin; end--) {
+    uint8_t c = (uint8_t)end[-1];
+    if (((set->bits[c / 64] >> (c % 64)) & 1) != member) {
+      break;
+    }
+  }
+  return end;
+}
+
+void ccursor_scalar_swap_array16(uint16_t *values, const char *bytes,
+                                 size_t count) {
+  for (size_t idx = 0; idx < count; idx++) {
+    uint16_t raw;
+    memcpy(&raw, bytes + idx * sizeof(raw), sizeof(raw));
+    values[idx] = _bswap16(raw);
+  }
+}
+
+void ccursor_scalar_swap_array32(uint32_t *values, const char *bytes,
+                                 size_t count) {
+  for (size_t idx = 0; idx < count; idx++) {
+    uint32_t raw;
+    memcpy(&raw, bytes + idx * sizeof(raw), sizeof(raw));
+    values[idx] = _bswap32(raw);
+  }
+}
+
+void ccursor_scalar_swap_array64(uint64_t *values, const char *bytes,
+                                 size_t count) {
+  for (size_t idx = 0; idx < count; idx++) {
+    uint64_t raw;
+    memcpy(&raw, bytes + idx * sizeof(raw), sizeof(raw));
+    values[idx] = _bswap64(raw);
+  }
+}
+
+/**
+ * @brief Block decoding is not available without SIMD, decodes nothing
+ */
+static const char *ccursor_scalar_decode_varints32(const char *p,
+                                                   const char *end,
+                                                   uint32_t *values,
+                                                   size_t count,
+                                                   size_t *decoded) {
+  (void)end;
+  (void)values;
+  (void)count;
+  *decoded = 0;
+  return p;
+}
+
+/**
+ * @brief Block conversion is not available without SIMD, converts nothing
+ */
+static size_t ccursor_scalar_convert_list_block(const char **p,
+                                                const char *end, char sep,
+                                                uint32_t *values, size_t max,
+                                                const char **last_end) {
+  (void)p;
+  (void)end;
+  (void)sep;
+  (void)values;
+  (void)max;
+  (void)last_end;
+  return 0;
+}
+
+const ccursor_kernels_t ccursor_kernels_scalar = {
+    .isa = "scalar",
+    .find_char = ccursor_scalar_find_char,
+    .rfind_char = ccursor_scalar_rfind_char,
+    .count_char = ccursor_scalar_count_char,
+    .match_mask = ccursor_scalar_match_mask,
+    .span = ccursor_scalar_span,
+    .rspan = ccursor_scalar_rspan,
+    .swap_array16 = ccursor_scalar_swap_array16,
+    .swap_array32 = ccursor_scalar_swap_array32,
+    .swap_array64 = ccursor_scalar_swap_array64,
+    .decode_varints32 = ccursor_scalar_decode_varints32,
+    .convert_list_block = ccursor_scalar_convert_list_block,
+};
@@ -0,0 +1,266 @@
+#include "ccursor_kernels.h"
+
+#include <emmintrin.h>
+
+static const char *ccursor_sse2_find_char(const char *begin, const char *end,
+                                          char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  while (end - begin >= 16) {
+    __m128i block = _mm_loadu_si128((const __m128i *)begin);
+    uint32_t mask =
+        (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return begin + _ctz32(mask);
+    }
+    begin += 16;
+  }
+  return ccursor_scalar_find_char(begin, end, c);
+}
+
+/**
+ * @brief Searches blocks from the end, the head is left to the scalar code
+ */
+static const char *ccursor_sse2_rfind_char(const char *begin, const char *end,
+                                           char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  const char *p = end;
+  while (p - begin >= 16) {
+    __m128i block = _mm_loadu_si128((const __m128i *)(p - 16));
+    uint32_t mask =
+        (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return p - 1 - (_clz32(mask) - 16);
+    }
+    p -= 16;
+  }
+  const char *found = ccursor_scalar_rfind_char(begin, p, c);
+  return (found != p) ? found : end;
+}
+
+/**
+ * @brief Counts matches in byte counters, which are summed up before they
+ *        can overflow after 255 blocks
+ */
+static size_t ccursor_sse2_count_char(const char *begin, const char *end,
+                                      char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  size_t count = 0;
+
+  while (end - begin >= 16) {
+    size_t blocks = (size_t)(end - begin) / 16;
+    const char *stop = begin + 16 * (blocks < 255 ? blocks : 255);
+    __m128i counters = _mm_setzero_si128();
+    for (; begin < stop; begin += 16) {
+      __m128i block = _mm_loadu_si128((const __m128i *)begin);
+      counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(block, needle));
+    }
+    __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+    count += (size_t)_mm_cvtsi128_si32(sums) +
+             (size_t)_mm_extract_epi16(sums, 4);
+  }
+
+  return count + ccursor_scalar_count_char(begin, end, c);
+}
+
+static uint64_t ccursor_sse2_match_mask(const char *block, char a, char b) {
+  const __m128i first = _mm_set1_epi8(a);
+  const __m128i second = _mm_set1_epi8(b);
+  uint64_t mask = 0;
+  for (uint32_t idx = 0; idx < 64; idx += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(block + idx));
+    __m128i match =
+        _mm_or_si128(_mm_cmpeq_epi8(v, first), _mm_cmpeq_epi8(v, second));
+    mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(match) << idx;
+  }
+  return mask;
+}
+
+static void ccursor_sse2_swap_array16(uint16_t *values, const char *bytes,
+                                      size_t count) {
+  size_t idx = 0;
+  for (; idx + 8 <= count; idx += 8) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(bytes + idx * 2));
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    _mm_storeu_si128((__m128i *)(values + idx), v);
+  }
+  ccursor_scalar_swap_array16(values + idx, bytes + idx * 2, count - idx);
+}
+
+static void ccursor_sse2_swap_array32(uint32_t *values, const char *bytes,
+                                      size_t count) {
+  size_t idx = 0;
+  for (; idx + 4 <= count; idx += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(bytes + idx * 4));
+    // swap the 16-bit halves, then the bytes within each half
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    _mm_storeu_si128((__m128i *)(values + idx), v);
+  }
+  ccursor_scalar_swap_array32(values + idx, bytes + idx * 4, count - idx);
+}
+
+static void ccursor_sse2_swap_array64(uint64_t *values, const char *bytes,
+                                      size_t count) {
+  size_t idx = 0;
+  for (; idx + 2 <= count; idx += 2) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(bytes + idx * 8));
+    // reverse the 16-bit quarters, then the bytes within each quarter
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    _mm_storeu_si128((__m128i *)(values + idx), v);
+  }
+  ccursor_scalar_swap_array64(values + idx, bytes + idx * 8, count - idx);
+}
+
+/**
+ * @brief Decodes LEB128 varints of at most 32 bits in blocks of 16 bytes
+ *
+ * Blocks of 16 bytes are classified with a single movemask of their
+ * continuation bits. Blocks without any continuation bit are widened
+ * directly, otherwise each varint terminated within the block is extracted
+ * branch-free from an 8 byte load. Stops 24 bytes before the end.
+ */
+const char *ccursor_sse2_decode_varints32(const char *p, const char *end,
+                                          uint32_t *values, size_t count,
+                                          size_t *decoded) {
+  size_t idx = 0;
+
+  while (idx < count && end - p >= 24) {
+    __m128i block = _mm_loadu_si128((const __m128i *)p);
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(block);
+
+    if (mask == 0 && count - idx >= 16) {
+      // 16 single byte varints, zero extend them
+      const __m128i zero = _mm_setzero_si128();
+      __m128i low = _mm_unpacklo_epi8(block, zero);
+      __m128i high = _mm_unpackhi_epi8(block, zero);
+      _mm_storeu_si128((__m128i *)(values + idx),
+                       _mm_unpacklo_epi16(low, zero));
+      _mm_storeu_si128((__m128i *)(values + idx + 4),
+                       _mm_unpackhi_epi16(low, zero));
+      _mm_storeu_si128((__m128i *)(values + idx + 8),
+                       _mm_unpacklo_epi16(high, zero));
+      _mm_storeu_si128((__m128i *)(values + idx + 12),
+                       _mm_unpackhi_epi16(high, zero));
+      idx += 16;
+      p += 16;
+      continue;
+    }
+
+    uint32_t terminators = ~mask & 0xFFFF;
+    uint32_t pos = 0;
+    while (terminators != 0 && idx < count) {
+      uint32_t last = _ctz32(terminators);
+      uint32_t length = last - pos + 1;
+      if (length > 5) {
+        return NULL;
+      }
+
+      uint64_t raw = ccursor_load_chars(p + pos);
+      raw &= 0xFFFFFFFFFFFFFFFFULL >> (64 - 8 * length);
+      if ((raw >> 32) > 0x0F) {
+        return NULL;
+      }
+      values[idx++] = (uint32_t)((raw & 0x7F) | ((raw >> 1) & 0x3F80) |
+                                 ((raw >> 2) & 0x1FC000) |
+                                 ((raw >> 3) & 0xFE00000) |
+                                 ((raw >> 4) & 0xF0000000));
+
+      terminators &= terminators - 1;
+      pos = last + 1;
+    }
+
+    if (pos == 0) {
+      // no varint ends within 16 bytes
+      return NULL;
+    }
+    p += pos;
+  }
+
+  *decoded = idx;
+  return p;
+}
+
+/**
+ * @brief Converts runs of plain digits terminated by a separator in bulk
+ *
+ * Classifies 16 characters at once into digits and separators. Every run of
+ * 1 to 8 digits which is followed by a separator is converted with a single
+ * zero-padded SWAR conversion. Stops at anything else, e.g. signs, spaces or
+ * longer runs, which are left to the scalar element parser.
+ */
+size_t ccursor_sse2_convert_list_block(const char **p, const char *end,
+                                       char sep, uint32_t *values, size_t max,
+                                       const char **last_end) {
+  const __m128i bias = _mm_set1_epi8((char)0x80);
+  const __m128i below = _mm_set1_epi8((char)(('0' - 1) ^ 0x80));
+  const __m128i above = _mm_set1_epi8((char)(('9' + 1) ^ 0x80));
+  const __m128i separator = _mm_set1_epi8(sep);
+  const char *q = *p;
+  size_t count = 0;
+
+  while (count < max && end - q >= 24) {
+    __m128i block = _mm_loadu_si128((const __m128i *)q);
+    __m128i biased = _mm_xor_si128(block, bias);
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(biased, below),
+                                  _mm_cmplt_epi8(biased, above));
+    uint32_t digits = (uint32_t)_mm_movemask_epi8(digit);
+    uint32_t separators =
+        (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, separator));
+
+    // only the leading part made of digits and separators is of interest
+    uint32_t other = ~(digits | separators) & 0xFFFF;
+    uint32_t limit = (other != 0) ? (uint32_t)_ctz32(other) : 16;
+    separators &= (1U << limit) - 1;
+
+    uint32_t pos = 0;
+    while (separators != 0 && count < max) {
+      uint32_t at = _ctz32(separators);
+      uint32_t length = at - pos;
+      if (length == 0 || length > 8) {
+        break;
+      }
+
+      uint64_t chunk = ccursor_load_chars(q + pos);
+      // move the digits to the end and pad the front with '0'
+      chunk <<= 8 * (8 - length);
+      if (length < 8) {
+        chunk |= 0x3030303030303030ULL >> (8 * length);
+      }
+      values[count++] = ccursor_swar_parse_8digits(chunk);
+
+      *last_end = q + at;
+      separators &= separators - 1;
+      pos = at + 1;
+    }
+
+    if (pos == 0) {
+      break;
+    }
+    q += pos;
+    if (separators != 0) {
+      break;
+    }
+  }
+
+  *p = q;
+  return count;
+}
+
+// the nibble lookup needs PSHUFB of SSSE3, SSE2 keeps the scalar bitmap
+const ccursor_kernels_t ccursor_kernels_sse2 = {
+    .isa = "sse2",
+    .find_char = ccursor_sse2_find_char,
+    .rfind_char = ccursor_sse2_rfind_char,
+    .count_char = ccursor_sse2_count_char,
+    .match_mask = ccursor_sse2_match_mask,
+    .span = ccursor_scalar_span,
+    .rspan = ccursor_scalar_rspan,
+    .swap_array16 = ccursor_sse2_swap_array16,
+    .swap_array32 = ccursor_sse2_swap_array32,
+    .swap_array64 = ccursor_sse2_swap_array64,
+    .decode_varints32 = ccursor_sse2_decode_varints32,
+    .convert_list_block = ccursor_sse2_convert_list_block,
+};
@@ -0,0 +1,291 @@
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
+
+/**
+ * @brief Element types of delimited number lists
+ */
+typedef enum {
+  CCURSOR_LIST_U32,
+  CCURSOR_LIST_I32,
+  CCURSOR_LIST_HEX,
+} ccursor_list_type_t;
+
+/**
+ * @brief Parses a single list element
+ *
+ * @param[in]  p     - first character of the element
+ * @param[in]  end   - end of the readable area
+ * @param[in]  type  - element type
+ * @param[out] value - parsed value, signed values are stored two's complement
+ * @return pointer behind the element on success, else NULL
+ */
+static const char *ccursor_list_parse_element(const char *p, const char *end,
+                                              ccursor_list_type_t type,
+                                              uint32_t *value) {
+  bool negative = false;
+  uint64_t num = 0;
+
+  switch (type) {
+  case CCURSOR_LIST_U32:
+    p = ccursor_parse_integer(p, end, &negative, &num);
+    if (p == NULL || num > _UINT32_MAX || (negative && num != 0)) {
+      return NULL;
+    }
+    *value = (uint32_t)num;
+    return p;
+  case CCURSOR_LIST_I32:
+    p = ccursor_parse_integer(p, end, &negative, &num);
+    if (p == NULL ||
+        num > (negative ? (uint64_t)_INT32_MAX + 1 : (uint64_t)_INT32_MAX)) {
+      return NULL;
+    }
+    *value = negative ? (uint32_t)(0 - num) : (uint32_t)num;
+    return p;
+  case CCURSOR_LIST_HEX:
+    return ccursor_parse_hex(p, end, value);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Reads a delimited list of numbers, see ccursor_read_u32_list
+ *
+ * @param[in,out] handle - The char cursor handle
+ * @param[in]     sep    - separator character
+ * @param[in]     type   - element type
+ * @param[out]    values - parsed values
+ * @param[in]     max    - capacity of values
+ * @param[out]    count  - number of parsed values
+ * @return see ccursor_read_u32_list
+ */
+static ccursor_ret_t ccursor_read_list(ccursor_handle_t *handle, char sep,
+                                       ccursor_list_type_t type,
+                                       uint32_t *values, size_t max,
+                                       size_t *count) {
+  if (handle == NULL || values == NULL || count == NULL || max == 0 ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const char *const end = CCURSOR_END(handle);
+  const char *p = handle->read_position;
+  const char *last_end = NULL;
+  size_t parsed = 0;
+
+  while (parsed < max) {
+    if (type != CCURSOR_LIST_HEX) {
+      parsed += ccursor_kernels->convert_list_block(
+          &p, end, sep, values + parsed, max - parsed, &last_end);
+      if (parsed == max) {
+        break;
+      }
+    }
+
+    const char *element_end =
+        ccursor_list_parse_element(p, end, type, &values[parsed]);
+    if (element_end == NULL) {
+      break;
+    }
+    parsed++;
+    last_end = element_end;
+
+    // a trailing separator is only consumed together with the next element
+    if (element_end >= end || *element_end != sep) {
+      break;
+    }
+    p = element_end + 1;
+  }
+
+  if (parsed == 0) {
+    *count = 0;
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  *count = parsed;
+  handle->read_position = (char *)last_end;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_read_u32_list(ccursor_handle_t *handle, char sep,
+                                    uint32_t *values, size_t max,
+                                    size_t *count) {
+  return ccursor_read_list(handle, sep, CCURSOR_LIST_U32, values, max, count);
+}
+
+ccursor_ret_t ccursor_read_i32_list(ccursor_handle_t *handle, char sep,
+                                    int32_t *values, size_t max,
+                                    size_t *count) {
+  return ccursor_read_list(handle, sep, CCURSOR_LIST_I32, (uint32_t *)values,
+                           max, count);
+}
+
+ccursor_ret_t ccursor_read_hex_list(ccursor_handle_t *handle, char sep,
+                                    uint32_t *values, size_t max,
+                                    size_t *count) {
+  return ccursor_read_list(handle, sep, CCURSOR_LIST_HEX, values, max, count);
+}
+
+// values converted at once by the block converter while aggregating
+#define CCURSOR_AGGREGATE_BATCH 64
+// largest scale for which a converted batch cannot overflow the sum
+#define CCURSOR_AGGREGATE_BATCH_MAX_SCALE 8
+// upper bound of a batch sum, 8 digit values at the largest batch scale
+#define CCURSOR_AGGREGATE_BATCH_HEADROOM                                       \
+  ((int64_t)CCURSOR_AGGREGATE_BATCH * 10000000000000000LL)
+
+/**
+ * @brief Running aggregates, kept in locals while parsing
+ */
+typedef struct {
+  uint64_t count;
+  int64_t sum;
+  int64_t min;
+  int64_t max;
+} ccursor_aggregate_t;
+
+/**
+ * @brief Counts a value in the histogram of stats, if there is one
+ *
+ * @param[in,out] stats - aggregates holding the histogram configuration
+ * @param[in]     value - value to count
+ */
+static inline void ccursor_histogram_add(ccursor_stats_t *stats,
+                                         int64_t value) {
+  if (stats->histogram == NULL) {
+    return;
+  }
+
+  size_t bucket = 0;
+  if (value > stats->histogram_min) {
+    uint64_t offset = (uint64_t)value - (uint64_t)stats->histogram_min;
+    uint64_t index = offset / (uint64_t)stats->histogram_width;
+    bucket = (index < stats->histogram_buckets) ? (size_t)index
+                                                : stats->histogram_buckets - 1;
+  }
+  stats->histogram[bucket]++;
+}
+
+/**
+ * @brief Adds a single value to the aggregates
+ *
+ * @param[in,out] aggregate - running aggregates
+ * @param[in]     value     - value to add
+ * @return true on success, false if the sum would overflow
+ */
+static inline bool ccursor_aggregate_add(ccursor_aggregate_t *aggregate,
+                                         int64_t value) {
+  int64_t sum;
+  if (_add_overflow(aggregate->sum, value, &sum)) {
+    return false;
+  }
+
+  aggregate->sum = sum;
+  aggregate->min = (value < aggregate->min) ? value : aggregate->min;
+  aggregate->max = (value > aggregate->max) ? value : aggregate->max;
+  aggregate->count++;
+  return true;
+}
+
+/**
+ * @brief Adds a batch of converted values to the aggregates
+ *
+ * The reduction runs over plain arrays without dependencies between the
+ * elements, which allows the compiler to vectorize it. The caller ensures
+ * that the sum cannot overflow.
+ *
+ * @param[in,out] aggregate  - running aggregates
+ * @param[in]     values     - unscaled values
+ * @param[in]     count      - number of values
+ * @param[in]     multiplier - scale factor of the values
+ */
+static void ccursor_aggregate_batch(ccursor_aggregate_t *aggregate,
+                                    const uint32_t *values, size_t count,
+                                    uint64_t multiplier) {
+  uint64_t sum = 0;
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+  for (size_t idx = 0; idx < count; idx++) {
+    sum += values[idx];
+    min = (values[idx] < min) ? values[idx] : min;
+    max = (values[idx] > max) ? values[idx] : max;
+  }
+
+  int64_t scaled_min = (int64_t)(min * multiplier);
+  int64_t scaled_max = (int64_t)(max * multiplier);
+  aggregate->sum += (int64_t)(sum * multiplier);
+  aggregate->min = (scaled_min < aggregate->min) ? scaled_min : aggregate->min;
+  aggregate->max = (scaled_max > aggregate->max) ? scaled_max : aggregate->max;
+  aggregate->count += count;
+}
+
+ccursor_ret_t ccursor_aggregate_numbers(ccursor_handle_t *handle, char sep,
+                                        ccursor_stats_t *stats) {
+  if (handle == NULL || stats == NULL ||
+      stats->scale > CCURSOR_DECIMAL_MAX_SCALE ||
+      (stats->histogram != NULL &&
+       (stats->histogram_buckets == 0 || stats->histogram_width <= 0)) ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const char *const end = CCURSOR_END(handle);
+  const char *p = handle->read_position;
+  const char *last_end = NULL;
+
+  ccursor_aggregate_t aggregate = {
+      .count = 0,
+      .sum = stats->sum,
+      .min = (stats->count != 0) ? stats->min : _INT64_MAX,
+      .max = (stats->count != 0) ? stats->max : _INT64_MIN,
+  };
+
+  const uint64_t multiplier = ccursor_powers_of_ten[stats->scale];
+  uint32_t batch[CCURSOR_AGGREGATE_BATCH];
+
+  while (true) {
+    while (stats->scale <= CCURSOR_AGGREGATE_BATCH_MAX_SCALE &&
+           aggregate.sum < _INT64_MAX - CCURSOR_AGGREGATE_BATCH_HEADROOM) {
+      size_t converted = ccursor_kernels->convert_list_block(
+          &p, end, sep, batch, CCURSOR_AGGREGATE_BATCH, &last_end);
+      if (converted == 0) {
+        break;
+      }
+      ccursor_aggregate_batch(&aggregate, batch, converted, multiplier);
+      if (stats->histogram != NULL) {
+        for (size_t idx = 0; idx < converted; idx++) {
+          ccursor_histogram_add(stats, (int64_t)(batch[idx] * multiplier));
+        }
+      }
+    }
+
+    int64_t value = 0;
+    const char *element_end =
+        ccursor_parse_decimal(p, end, stats->scale, stats->mode, &value);
+    if (element_end == NULL || !ccursor_aggregate_add(&aggregate, value)) {
+      break;
+    }
+    ccursor_histogram_add(stats, value);
+    last_end = element_end;
+
+    // a trailing separator is only consumed together with the next element
+    if (sep == '\n' && element_end < end && *element_end == '\r') {
+      element_end++;
+    }
+    if (element_end >= end || *element_end != sep) {
+      break;
+    }
+    p = element_end + 1;
+  }
+
+  if (aggregate.count == 0) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  stats->count += aggregate.count;
+  stats->sum = aggregate.sum;
+  stats->min = aggregate.min;
+  stats->max = aggregate.max;
+  handle->read_position = (char *)last_end;
+  return E_CCURSOR_OK;
+}
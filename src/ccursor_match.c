@@ -0,0 +1,526 @@
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
+
+// seeds tried before the search for a perfect hash gives up
+#define CCURSOR_KEYWORD_SEEDS 16
+
+/**
+ * @brief Default whitespace class " \t\n\v\f\r" of the trim functions
+ *
+ * The nibble tables hold two groups, the row of '\t' to '\r' below 0x10 and
+ * the row of ' ' below 0x30.
+ */
+static const ccursor_charset_t ccursor_whitespace = {
+    .bits = {0x0000000100003E00ULL, 0, 0, 0},
+    .low = {2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0},
+    .high = {1, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    .nibbles = true,
+};
+
+/**
+ * @brief Checks whether a prefix passes through a trie node
+ *
+ * @param[in]  prefix - prefix of the table
+ * @param[in]  path   - characters leading to the node
+ * @param[in]  depth  - number of characters leading to the node
+ * @return true if the prefix starts with the path
+ */
+static bool ccursor_prefix_passes(const char *prefix, const char *path,
+                                  size_t depth) {
+  return _strlen(prefix) >= depth && memcmp(prefix, path, depth) == 0;
+}
+
+/**
+ * @brief Builds the subtrie below a node
+ *
+ * The children of a node are allocated together, so they end up one after
+ * another and sorted by their label. The path of a node is taken from any
+ * prefix passing through it.
+ *
+ * @param[in,out] set      - prefix set with the node allocated
+ * @param[in]     prefixes - table of prefixes
+ * @param[in]     count    - number of prefixes
+ * @param[in]     node     - index of the node
+ * @param[in]     path     - characters leading to the node
+ * @param[in]     depth    - number of characters leading to the node
+ * @return E_CCURSOR_OK on success
+ * @return E_CCURSOR_ERR_PARAM on a duplicated prefix or too many nodes
+ */
+static ccursor_ret_t ccursor_prefix_build(ccursor_prefix_set_t *set,
+                                          const char *const *prefixes,
+                                          size_t count, size_t node,
+                                          const char *path, size_t depth) {
+  uint64_t labels[4] = {0};
+  for (size_t idx = 0; idx < count; idx++) {
+    if (!ccursor_prefix_passes(prefixes[idx], path, depth)) {
+      continue;
+    }
+
+    uint8_t label = (uint8_t)prefixes[idx][depth];
+    if (label == '\0') {
+      if (set->nodes[node].prefix >= 0) {
+        return E_CCURSOR_ERR_PARAM;
+      }
+      set->nodes[node].prefix = (int16_t)idx;
+    } else {
+      labels[label / 64] |= (uint64_t)1 << (label % 64);
+    }
+  }
+
+  size_t children = 0;
+  for (size_t word = 0; word < 4; word++) {
+    children += (size_t)_popcount64(labels[word]);
+  }
+  if (children > CCURSOR_PREFIX_MAX_NODES - set->node_count) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  size_t child = set->node_count;
+  set->nodes[node].children = (uint16_t)child;
+  set->nodes[node].count = (uint8_t)children;
+  set->node_count += children;
+
+  for (size_t word = 0; word < 4; word++) {
+    for (uint64_t bits = labels[word]; bits != 0; bits &= bits - 1) {
+      uint8_t label = (uint8_t)(word * 64 + (size_t)_ctz64(bits));
+      set->nodes[child].label = label;
+      set->nodes[child].prefix = -1;
+      set->nodes[child].count = 0;
+
+      // any prefix continuing with the label provides the path of the child
+      size_t idx = 0;
+      while (!ccursor_prefix_passes(prefixes[idx], path, depth) ||
+             (uint8_t)prefixes[idx][depth] != label) {
+        idx++;
+      }
+
+      ccursor_ret_t ret = ccursor_prefix_build(set, prefixes, count, child,
+                                               prefixes[idx], depth + 1);
+      if (ret != E_CCURSOR_OK) {
+        return ret;
+      }
+      child++;
+    }
+  }
+
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_prefix_init(ccursor_prefix_set_t *set,
+                                  const char *const *prefixes, size_t count) {
+  if (set == NULL || (prefixes == NULL && count > 0) || count > _INT16_MAX) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  for (size_t idx = 0; idx < count; idx++) {
+    if (prefixes[idx] == NULL || prefixes[idx][0] == '\0') {
+      return E_CCURSOR_ERR_PARAM;
+    }
+  }
+
+  set->nodes[0].label = 0;
+  set->nodes[0].prefix = -1;
+  set->nodes[0].count = 0;
+  set->node_count = 1;
+
+  return ccursor_prefix_build(set, prefixes, count, 0, "", 0);
+}
+
+ccursor_ret_t ccursor_skip_prefix(ccursor_handle_t *handle,
+                                  const ccursor_prefix_set_t *set,
+                                  size_t *index) {
+  if (handle == NULL || set == NULL || index == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const ccursor_prefix_node_t *node = &set->nodes[0];
+  const char *p = handle->read_position;
+  const char *const end = CCURSOR_END(handle);
+  const char *matched = NULL;
+
+  // walk down the trie and remember the longest prefix passed
+  while (p < end && node->count > 0) {
+    const ccursor_prefix_node_t *child = &set->nodes[node->children];
+    const ccursor_prefix_node_t *const last = child + node->count;
+    while (child < last && child->label < (uint8_t)*p) {
+      child++;
+    }
+    if (child == last || child->label != (uint8_t)*p) {
+      break;
+    }
+
+    node = child;
+    p++;
+    if (node->prefix >= 0) {
+      *index = (size_t)node->prefix;
+      matched = p;
+    }
+  }
+
+  if (matched == NULL) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  handle->read_position = (char *)matched;
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Derives the nibble tables of a character class
+ *
+ * Each high nibble selects a row of 16 characters. High nibbles with the
+ * same row share a group bit, and each low nibble carries the bits of the
+ * groups whose row contains it. With more than 8 distinct rows the tables
+ * cannot describe the class and only the bitmap is used.
+ *
+ * @param[in,out] set - character class with its bitmap
+ */
+static void ccursor_charset_nibbles(ccursor_charset_t *set) {
+  uint16_t groups[8];
+  size_t count = 0;
+
+  memset(set->low, 0, sizeof(set->low));
+  memset(set->high, 0, sizeof(set->high));
+  set->nibbles = true;
+  for (uint32_t high = 0; high < 16; high++) {
+    uint16_t row = (uint16_t)(set->bits[high / 4] >> (high % 4 * 16));
+    if (row == 0) {
+      continue;
+    }
+
+    size_t group = 0;
+    while (group < count && groups[group] != row) {
+      group++;
+    }
+    if (group == count) {
+      if (count == 8) {
+        set->nibbles = false;
+        return;
+      }
+      groups[count++] = row;
+    }
+
+    set->high[high] = (uint8_t)(1U << group);
+    for (uint32_t low = 0; low < 16; low++) {
+      if ((row >> low) & 1) {
+        set->low[low] |= (uint8_t)(1U << group);
+      }
+    }
+  }
+}
+
+ccursor_ret_t ccursor_charset_init(ccursor_charset_t *set, const char *spec) {
+  if (set == NULL || spec == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  memset(set->bits, 0, sizeof(set->bits));
+  const char *p = spec;
+  while (*p != '\0') {
+    if (*p == '\\' && *++p == '\0') {
+      return E_CCURSOR_ERR_PARAM;
+    }
+    uint8_t first = (uint8_t)*p++;
+    uint8_t last = first;
+
+    // a range needs a character behind the '-', else it is a member
+    if (p[0] == '-' && p[1] != '\0') {
+      p++;
+      if (*p == '\\' && *++p == '\0') {
+        return E_CCURSOR_ERR_PARAM;
+      }
+      last = (uint8_t)*p++;
+      if (last < first) {
+        return E_CCURSOR_ERR_PARAM;
+      }
+    }
+
+    for (uint32_t c = first; c <= last; c++) {
+      set->bits[c / 64] |= (uint64_t)1 << (c % 64);
+    }
+  }
+
+  ccursor_charset_nibbles(set);
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Skips characters as long as their membership in a class matches
+ *
+ * @param[in,out] handle - char cursor handle
+ * @param[in]     set    - character class
+ * @param[in]     member - skip members if true, else non-members
+ * @param[out]    length - number of skipped characters, or NULL
+ * @return E_CCURSOR_OK on success
+ * @return E_CCURSOR_ERR_PARAM on invalid arguments or an empty stream
+ */
+static ccursor_ret_t ccursor_skip_class(ccursor_handle_t *handle,
+                                        const ccursor_charset_t *set,
+                                        bool member, size_t *length) {
+  if (handle == NULL || set == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const char *stop = ccursor_kernels->span(handle->read_position,
+                                           CCURSOR_END(handle), set, member);
+  if (length != NULL) {
+    *length = (size_t)(stop - handle->read_position);
+  }
+  handle->read_position = (char *)stop;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_span(ccursor_handle_t *handle,
+                           const ccursor_charset_t *set, size_t *length) {
+  return ccursor_skip_class(handle, set, true, length);
+}
+
+ccursor_ret_t ccursor_cspan(ccursor_handle_t *handle,
+                            const ccursor_charset_t *set, size_t *length) {
+  return ccursor_skip_class(handle, set, false, length);
+}
+
+ccursor_ret_t ccursor_trim_left_ws(ccursor_handle_t *handle,
+                                   const ccursor_charset_t *whitespace) {
+  return ccursor_skip_class(
+      handle, (whitespace != NULL) ? whitespace : &ccursor_whitespace, true,
+      NULL);
+}
+
+ccursor_ret_t ccursor_trim_right(ccursor_handle_t *handle,
+                                 const ccursor_charset_t *whitespace) {
+  if (handle == NULL || handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const char *end = ccursor_kernels->rspan(
+      handle->read_position, CCURSOR_END(handle),
+      (whitespace != NULL) ? whitespace : &ccursor_whitespace, true);
+  handle->buffer_size = (uint32_t)(end - handle->buffer);
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_trim(ccursor_handle_t *handle,
+                           const ccursor_charset_t *whitespace) {
+  ccursor_ret_t ret = ccursor_trim_left_ws(handle, whitespace);
+  if (ret != E_CCURSOR_OK || handle->read_position >= CCURSOR_END(handle)) {
+    return ret;
+  }
+  return ccursor_trim_right(handle, whitespace);
+}
+
+/**
+ * @brief Hashes a token with a seed
+ *
+ * @param[in]  p      - first character of the token
+ * @param[in]  length - length of the token
+ * @param[in]  seed   - seed of the hash
+ * @return 64-bit hash, all bits depend on all characters
+ */
+static uint64_t ccursor_keyword_hash(const char *p, size_t length,
+                                     uint64_t seed) {
+  uint64_t hash = 0xcbf29ce484222325ULL ^ seed;
+  for (size_t idx = 0; idx < length; idx++) {
+    hash = (hash ^ (uint8_t)p[idx]) * 0x100000001b3ULL;
+  }
+
+  // FNV-1a leaves the high bits weak, finish like murmur3
+  hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdULL;
+  hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+  return hash ^ (hash >> 33);
+}
+
+/**
+ * @brief Maps a hash to its bucket
+ *
+ * @param[in]  set  - keyword set
+ * @param[in]  hash - hash of the token
+ * @return index of the bucket
+ */
+static uint32_t ccursor_keyword_bucket(const ccursor_keyword_set_t *set,
+                                       uint64_t hash) {
+  return (uint32_t)(((hash >> 32) * set->buckets) >> 32);
+}
+
+/**
+ * @brief Maps a hash to its slot
+ *
+ * @param[in]  set          - keyword set
+ * @param[in]  hash         - hash of the token
+ * @param[in]  displacement - displacement of the bucket, the factor of the
+ *                            second hash in the high and the offset in the
+ *                            low byte
+ * @return index of the slot
+ */
+static uint32_t ccursor_keyword_slot(const ccursor_keyword_set_t *set,
+                                     uint64_t hash, uint32_t displacement) {
+  uint32_t f1 = (uint32_t)hash;
+  uint32_t f2 = (uint32_t)(hash >> 8) | 1;
+  return (f1 + (displacement >> 8) * f2 + (displacement & 0xff)) & set->mask;
+}
+
+/**
+ * @brief Searches the displacement of a bucket moving all its keywords into
+ *        free slots
+ *
+ * @param[in,out] set     - keyword set with the slots of larger buckets
+ * @param[in]     hashes  - hashes of the keywords
+ * @param[in]     members - table indices of the keywords of the bucket
+ * @param[in]     size    - number of keywords of the bucket
+ * @param[in]     bucket  - the bucket
+ * @return true if the keywords were placed, else false
+ */
+static bool ccursor_keyword_place(ccursor_keyword_set_t *set,
+                                  const uint64_t *hashes,
+                                  const uint8_t *members, size_t size,
+                                  uint32_t bucket) {
+  for (uint32_t factor = 0; factor <= set->mask; factor++) {
+    for (uint32_t offset = 0; offset <= set->mask; offset++) {
+      uint32_t displacement = (factor << 8) | offset;
+      size_t placed = 0;
+      while (placed < size) {
+        uint32_t slot =
+            ccursor_keyword_slot(set, hashes[members[placed]], displacement);
+        if (set->slots[slot] >= 0) {
+          break;
+        }
+        set->slots[slot] = members[placed];
+        placed++;
+      }
+      if (placed == size) {
+        set->displacements[bucket] = (uint16_t)displacement;
+        return true;
+      }
+
+      // free the slots taken by this attempt again
+      while (placed > 0) {
+        placed--;
+        set->slots[ccursor_keyword_slot(set, hashes[members[placed]],
+                                        displacement)] = -1;
+      }
+    }
+  }
+  return false;
+}
+
+ccursor_ret_t ccursor_keyword_init(ccursor_keyword_set_t *set,
+                                   const ccursor_keyword_t *table,
+                                   size_t count, char sep) {
+  if (set == NULL || (table == NULL && count > 0) ||
+      count > CCURSOR_KEYWORD_MAX) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  set->table = table;
+  set->sep = sep;
+  set->max_length = 0;
+  for (size_t idx = 0; idx < count; idx++) {
+    const char *keyword = table[idx].keyword;
+    if (keyword == NULL) {
+      return E_CCURSOR_ERR_PARAM;
+    }
+    size_t length = _strlen(keyword);
+    if (length == 0 || length > _UINT8_MAX ||
+        memchr(keyword, sep, length) != NULL) {
+      return E_CCURSOR_ERR_PARAM;
+    }
+    for (size_t other = 0; other < idx; other++) {
+      if (_strcmp(keyword, table[other].keyword) == 0) {
+        return E_CCURSOR_ERR_PARAM;
+      }
+    }
+    if (length > set->max_length) {
+      set->max_length = length;
+    }
+  }
+
+  // keep the load of the slots below 80%, the buckets hold 4 keywords
+  uint32_t slots = 1;
+  while (slots < count + count / 4) {
+    slots <<= 1;
+  }
+  set->mask = slots - 1;
+  set->buckets = (uint32_t)(count / 4 + 1);
+
+  uint64_t hashes[CCURSOR_KEYWORD_MAX];
+  uint8_t members[CCURSOR_KEYWORD_MAX];
+  for (uint64_t attempt = 0; attempt < CCURSOR_KEYWORD_SEEDS; attempt++) {
+    set->seed = attempt * 0x9e3779b97f4a7c15ULL;
+    for (size_t idx = 0; idx < CCURSOR_KEYWORD_SLOTS; idx++) {
+      set->slots[idx] = -1;
+    }
+    for (size_t idx = 0; idx < CCURSOR_KEYWORD_MAX; idx++) {
+      set->displacements[idx] = 0;
+    }
+
+    size_t sizes[CCURSOR_KEYWORD_MAX] = {0};
+    for (size_t idx = 0; idx < count; idx++) {
+      hashes[idx] = ccursor_keyword_hash(
+          table[idx].keyword, _strlen(table[idx].keyword), set->seed);
+      sizes[ccursor_keyword_bucket(set, hashes[idx])]++;
+    }
+
+    // place the largest buckets first while most slots are free
+    bool placed = true;
+    for (size_t size = count; size > 0 && placed; size--) {
+      for (uint32_t bucket = 0; bucket < set->buckets && placed; bucket++) {
+        if (sizes[bucket] != size) {
+          continue;
+        }
+        size_t used = 0;
+        for (size_t idx = 0; idx < count; idx++) {
+          if (ccursor_keyword_bucket(set, hashes[idx]) == bucket) {
+            members[used++] = (uint8_t)idx;
+          }
+        }
+        placed = ccursor_keyword_place(set, hashes, members, size, bucket);
+      }
+    }
+
+    if (placed) {
+      for (size_t idx = 0; idx < CCURSOR_KEYWORD_SLOTS; idx++) {
+        set->lengths[idx] =
+            (set->slots[idx] < 0)
+                ? 0
+                : (uint8_t)_strlen(table[set->slots[idx]].keyword);
+      }
+      return E_CCURSOR_OK;
+    }
+  }
+
+  return E_CCURSOR_ERR;
+}
+
+ccursor_ret_t ccursor_read_keyword(ccursor_handle_t *handle,
+                                   const ccursor_keyword_set_t *set,
+                                   uint32_t *value) {
+  if (handle == NULL || set == NULL || value == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  // a token longer than every keyword is rejected without scanning it all
+  const char *const p = handle->read_position;
+  const char *const end = CCURSOR_END(handle);
+  const char *const limit =
+      ((size_t)(end - p) > set->max_length) ? p + set->max_length + 1 : end;
+  const char *const found = ccursor_kernels->find_char(p, limit, set->sep);
+  if (found == limit && limit != end) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  size_t length = (size_t)(found - p);
+  uint64_t hash = ccursor_keyword_hash(p, length, set->seed);
+  uint32_t slot = ccursor_keyword_slot(
+      set, hash, set->displacements[ccursor_keyword_bucket(set, hash)]);
+  int16_t idx = set->slots[slot];
+  if (idx < 0 || set->lengths[slot] != length ||
+      memcmp(p, set->table[idx].keyword, length) != 0) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  *value = set->table[idx].value;
+  handle->read_position = (char *)((found == end) ? end : found + 1);
+  return E_CCURSOR_OK;
+}
@@ -0,0 +1,575 @@
+#define _GNU_SOURCE
+
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
+
+#include "ccursor_mux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// events fetched by a single epoll_wait
+#define CCURSOR_MUX_EVENTS 64
+
+/**
+ * @brief Final result code and the kind of frame it finishes
+ */
+typedef struct {
+  const char *code;          // the code or its prefix
+  bool prefix;               // the code is followed by details
+  ccursor_frame_type_t type; // kind of the finished frame
+} ccursor_mux_final_t;
+
+static const ccursor_mux_final_t ccursor_mux_finals[] = {
+    {"OK", false, E_CCURSOR_FRAME_OK},
+    {"ERROR", false, E_CCURSOR_FRAME_ERROR},
+    {"+CME ERROR:", true, E_CCURSOR_FRAME_ERROR},
+    {"+CMS ERROR:", true, E_CCURSOR_FRAME_ERROR},
+    {"NO CARRIER", false, E_CCURSOR_FRAME_ERROR},
+    {"NO DIALTONE", false, E_CCURSOR_FRAME_ERROR},
+    {"NO ANSWER", false, E_CCURSOR_FRAME_ERROR},
+    {"BUSY", false, E_CCURSOR_FRAME_ERROR},
+};
+
+/**
+ * @brief Frame queued for dispatching, the lines follow the item
+ */
+typedef struct ccursor_mux_item {
+  struct ccursor_mux_item *next;
+  ccursor_frame_t frame;
+  char data[];
+} ccursor_mux_item_t;
+
+/**
+ * @brief Worker thread with its queue of frames
+ */
+typedef struct {
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t ready;
+  ccursor_mux_item_t *head;
+  ccursor_mux_item_t *tail;
+  bool stop;
+  ccursor_frame_cb_t callback;
+} ccursor_mux_worker_t;
+
+/**
+ * @brief State of a modem
+ */
+typedef struct {
+  void *context;
+  bool pending;                         // a command awaits its result
+  bool discarding;                      // an overlong line is skipped
+  bool incomplete;                      // lines of the response were lost
+  size_t size;                          // received bytes
+  char buffer[CCURSOR_MUX_BUFFER_SIZE]; // incomplete line
+  char *response;                       // lines of the pending response
+  size_t response_size;
+  size_t response_capacity;
+} ccursor_mux_modem_t;
+
+struct ccursor_mux {
+  int epoll;
+  ccursor_mux_config_t config;
+  ccursor_prefix_set_t urcs;    // trie of the configured URC prefixes
+  pthread_mutex_t lock;         // guards the modems
+  ccursor_mux_modem_t **modems; // indexed by the descriptor
+  size_t capacity;
+  ccursor_mux_worker_t *workers;
+  size_t started; // number of started workers
+};
+
+/**
+ * @brief Creates a frame for dispatching
+ *
+ * @param[in] fd      - descriptor of the modem
+ * @param[in] context - context of the modem
+ * @param[in] type    - kind of frame
+ * @param[in] lines   - lines of the frame
+ * @param[in] size    - size of the lines
+ * @return the frame, NULL if it cannot be allocated
+ */
+static ccursor_mux_item_t *ccursor_mux_item(int fd, void *context,
+                                            ccursor_frame_type_t type,
+                                            const char *lines, size_t size) {
+  ccursor_mux_item_t *item = malloc(sizeof(ccursor_mux_item_t) + size + 1);
+  if (item == NULL) {
+    return NULL;
+  }
+
+  memcpy(item->data, lines, size);
+  item->data[size] = '\0';
+  item->next = NULL;
+  item->frame.fd = fd;
+  item->frame.context = context;
+  item->frame.type = type;
+  item->frame.lines.buffer = item->data;
+  item->frame.lines.buffer_size = (uint32_t)size;
+  item->frame.lines.read_position = item->data;
+  return item;
+}
+
+/**
+ * @brief Appends a frame to a list
+ *
+ * @param[in,out] list - last next pointer of the list
+ * @param[in]     item - frame to append, may be NULL
+ */
+static void ccursor_mux_append(ccursor_mux_item_t ***list,
+                               ccursor_mux_item_t *item) {
+  if (item != NULL) {
+    **list = item;
+    *list = &item->next;
+  }
+}
+
+/**
+ * @brief Determines if a line finishes a response
+ *
+ * @param[in] line   - the line without its line break
+ * @param[in] length - the length of the line
+ * @return the kind of the finished frame, E_CCURSOR_FRAME_URC if the line
+ *         does not finish the response
+ */
+static ccursor_frame_type_t ccursor_mux_final(const char *line,
+                                              size_t length) {
+  const size_t count = sizeof(ccursor_mux_finals) / sizeof(*ccursor_mux_finals);
+  for (size_t idx = 0; idx < count; idx++) {
+    const ccursor_mux_final_t *final = &ccursor_mux_finals[idx];
+    size_t code_length = _strlen(final->code);
+    if ((final->prefix ? length >= code_length : length == code_length) &&
+        memcmp(line, final->code, code_length) == 0) {
+      return final->type;
+    }
+  }
+  return E_CCURSOR_FRAME_URC;
+}
+
+/**
+ * @brief Checks if a line starts with one of the configured URC prefixes
+ *
+ * @param[in] mux    - multiplexer
+ * @param[in] line   - the line without its line break
+ * @param[in] length - the length of the line
+ * @return true if the line is a URC, else false
+ */
+static bool ccursor_mux_is_urc(const ccursor_mux_t *mux, const char *line,
+                               size_t length) {
+  ccursor_handle_t handle = {(char *)line, (uint32_t)length, (char *)line};
+  size_t index = 0;
+  return ccursor_skip_prefix(&handle, &mux->urcs, &index) == E_CCURSOR_OK;
+}
+
+/**
+ * @brief Splits the received bytes of a modem into frames
+ *
+ * @param[in]     mux   - multiplexer
+ * @param[in]     fd    - descriptor of the modem
+ * @param[in,out] modem - state of the modem
+ * @param[in,out] list  - list to append the frames to
+ */
+static void ccursor_mux_frame(const ccursor_mux_t *mux, int fd,
+                              ccursor_mux_modem_t *modem,
+                              ccursor_mux_item_t ***list) {
+  const char *p = modem->buffer;
+  const char *const end = modem->buffer + modem->size;
+
+  const char *newline;
+  if (modem->discarding) {
+    // skip the rest of an overlong line up to its line break
+    newline = ccursor_kernels->find_char(p, end, '\n');
+    if (newline == end) {
+      modem->size = 0;
+      return;
+    }
+    p = newline + 1;
+    modem->discarding = false;
+  }
+
+  while ((newline = ccursor_kernels->find_char(p, end, '\n')) != end) {
+    const char *const next = newline + 1;
+    size_t length = (size_t)(newline - p);
+    if (length > 0 && p[length - 1] == '\r') {
+      length--;
+    }
+
+    if (length == 0) {
+      // blank lines only separate the lines of a response
+    } else if (!modem->pending || ccursor_mux_is_urc(mux, p, length)) {
+      ccursor_mux_append(list, ccursor_mux_item(fd, modem->context,
+                                                E_CCURSOR_FRAME_URC, p,
+                                                (size_t)(next - p)));
+    } else {
+      size_t size = (size_t)(next - p);
+      if (modem->response_capacity - modem->response_size < size) {
+        size_t capacity = 2 * modem->response_capacity + size;
+        char *response = realloc(modem->response, capacity);
+        if (response != NULL) {
+          modem->response = response;
+          modem->response_capacity = capacity;
+        }
+      }
+      if (modem->response_capacity - modem->response_size >= size) {
+        memcpy(modem->response + modem->response_size, p, size);
+        modem->response_size += size;
+      } else {
+        modem->incomplete = true;
+      }
+
+      ccursor_frame_type_t type = ccursor_mux_final(p, length);
+      if (type != E_CCURSOR_FRAME_URC) {
+        // a response with lost lines must not pass for a successful one
+        if (modem->incomplete) {
+          type = E_CCURSOR_FRAME_ERROR;
+        }
+        ccursor_mux_append(list, ccursor_mux_item(fd, modem->context, type,
+                                                  modem->response,
+                                                  modem->response_size));
+        modem->pending = false;
+        modem->incomplete = false;
+        modem->response_size = 0;
+      }
+    }
+    p = next;
+  }
+
+  // keep an incomplete line, unless it fills the whole buffer
+  modem->size = (size_t)(end - p);
+  if (modem->size == CCURSOR_MUX_BUFFER_SIZE) {
+    if (modem->pending && !ccursor_mux_is_urc(mux, p, modem->size)) {
+      modem->incomplete = true;
+    }
+    modem->discarding = true;
+    modem->size = 0;
+  }
+  memmove(modem->buffer, p, modem->size);
+}
+
+/**
+ * @brief Looks up a modem
+ *
+ * @param[in] mux - multiplexer
+ * @param[in] fd  - descriptor of the modem
+ * @return the modem, NULL if fd is not added
+ */
+static ccursor_mux_modem_t *ccursor_mux_modem(const ccursor_mux_t *mux,
+                                              int fd) {
+  if (fd < 0 || (size_t)fd >= mux->capacity) {
+    return NULL;
+  }
+  return mux->modems[fd];
+}
+
+/**
+ * @brief Unregisters and releases a modem
+ *
+ * @param[in,out] mux - multiplexer
+ * @param[in]     fd  - descriptor of an added modem
+ */
+static void ccursor_mux_release(ccursor_mux_t *mux, int fd) {
+  ccursor_mux_modem_t *modem = mux->modems[fd];
+  epoll_ctl(mux->epoll, EPOLL_CTL_DEL, fd, NULL);
+  mux->modems[fd] = NULL;
+  free(modem->response);
+  free(modem);
+}
+
+/**
+ * @brief Reads all available bytes of a modem and frames them
+ *
+ * @param[in,out] mux  - multiplexer
+ * @param[in]     fd   - descriptor of an added modem
+ * @param[in,out] list - list to append the frames to
+ */
+static void ccursor_mux_receive(ccursor_mux_t *mux, int fd,
+                                ccursor_mux_item_t ***list) {
+  ccursor_mux_modem_t *modem = mux->modems[fd];
+
+  while (true) {
+    ssize_t size = read(fd, modem->buffer + modem->size,
+                        CCURSOR_MUX_BUFFER_SIZE - modem->size);
+    if (size > 0) {
+      modem->size += (size_t)size;
+      ccursor_mux_frame(mux, fd, modem, list);
+    } else if (size < 0 && errno == EINTR) {
+      continue;
+    } else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    } else {
+      // end of file or an error, e.g. EIO of a closed pseudo-terminal
+      ccursor_mux_append(list, ccursor_mux_item(fd, modem->context,
+                                                E_CCURSOR_FRAME_HANGUP, "",
+                                                0));
+      ccursor_mux_release(mux, fd);
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Runs the callback for the frames of a worker queue
+ *
+ * @param[in,out] arg - worker
+ * @return NULL
+ */
+static void *ccursor_mux_work(void *arg) {
+  ccursor_mux_worker_t *worker = arg;
+
+  pthread_mutex_lock(&worker->lock);
+  while (true) {
+    while (worker->head == NULL && !worker->stop) {
+      pthread_cond_wait(&worker->ready, &worker->lock);
+    }
+    ccursor_mux_item_t *item = worker->head;
+    if (item == NULL) {
+      break;
+    }
+    worker->head = item->next;
+    if (worker->head == NULL) {
+      worker->tail = NULL;
+    }
+
+    pthread_mutex_unlock(&worker->lock);
+    worker->callback(&item->frame);
+    free(item);
+    pthread_mutex_lock(&worker->lock);
+  }
+  pthread_mutex_unlock(&worker->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Queues a frame at the worker of its modem
+ *
+ * @param[in,out] mux  - multiplexer
+ * @param[in]     item - frame to queue
+ */
+static void ccursor_mux_queue(ccursor_mux_t *mux, ccursor_mux_item_t *item) {
+  ccursor_mux_worker_t *worker =
+      &mux->workers[(size_t)item->frame.fd % mux->config.workers];
+  item->next = NULL;
+
+  pthread_mutex_lock(&worker->lock);
+  if (worker->tail != NULL) {
+    worker->tail->next = item;
+  } else {
+    worker->head = item;
+  }
+  worker->tail = item;
+  pthread_cond_signal(&worker->ready);
+  pthread_mutex_unlock(&worker->lock);
+}
+
+ccursor_ret_t ccursor_mux_create(ccursor_mux_t **mux,
+                                 const ccursor_mux_config_t *config) {
+  if (mux == NULL || config == NULL || config->callback == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  ccursor_mux_t *created = calloc(1, sizeof(ccursor_mux_t));
+  if (created == NULL) {
+    return E_CCURSOR_ERR;
+  }
+
+  size_t urcs = 0;
+  while (config->urcs != NULL && config->urcs[urcs] != NULL) {
+    urcs++;
+  }
+  if (ccursor_prefix_init(&created->urcs, config->urcs, urcs) !=
+      E_CCURSOR_OK) {
+    free(created);
+    return E_CCURSOR_ERR_PARAM;
+  }
+  created->config = *config;
+  pthread_mutex_init(&created->lock, NULL);
+  created->epoll = epoll_create1(EPOLL_CLOEXEC);
+  if (config->workers > 0) {
+    created->workers = calloc(config->workers, sizeof(ccursor_mux_worker_t));
+  }
+  if (created->epoll < 0 || (config->workers > 0 && created->workers == NULL)) {
+    ccursor_mux_destroy(created);
+    return E_CCURSOR_ERR;
+  }
+
+  for (size_t idx = 0; idx < config->workers; idx++) {
+    ccursor_mux_worker_t *worker = &created->workers[idx];
+    worker->callback = config->callback;
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->ready, NULL);
+    if (pthread_create(&worker->thread, NULL, ccursor_mux_work, worker) != 0) {
+      pthread_cond_destroy(&worker->ready);
+      pthread_mutex_destroy(&worker->lock);
+      ccursor_mux_destroy(created);
+      return E_CCURSOR_ERR;
+    }
+    created->started++;
+  }
+
+  *mux = created;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_mux_add(ccursor_mux_t *mux, int fd, void *context) {
+  if (mux == NULL || fd < 0) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  pthread_mutex_lock(&mux->lock);
+  ccursor_ret_t ret = E_CCURSOR_OK;
+  if (ccursor_mux_modem(mux, fd) != NULL) {
+    ret = E_CCURSOR_ERR_PARAM;
+  } else if ((size_t)fd >= mux->capacity) {
+    size_t capacity = (2 * mux->capacity > (size_t)fd) ? 2 * mux->capacity
+                                                       : (size_t)fd + 1;
+    ccursor_mux_modem_t **modems =
+        realloc(mux->modems, capacity * sizeof(ccursor_mux_modem_t *));
+    if (modems == NULL) {
+      ret = E_CCURSOR_ERR;
+    } else {
+      memset(modems + mux->capacity, 0,
+             (capacity - mux->capacity) * sizeof(ccursor_mux_modem_t *));
+      mux->modems = modems;
+      mux->capacity = capacity;
+    }
+  }
+
+  ccursor_mux_modem_t *modem = NULL;
+  if (ret == E_CCURSOR_OK) {
+    modem = calloc(1, sizeof(ccursor_mux_modem_t));
+    int flags = fcntl(fd, F_GETFL);
+    struct epoll_event event = {.events = EPOLLIN, .data.fd = fd};
+    if (modem == NULL || flags < 0 ||
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0 ||
+        epoll_ctl(mux->epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+      free(modem);
+      ret = E_CCURSOR_ERR;
+    }
+  }
+  if (ret == E_CCURSOR_OK) {
+    modem->context = context;
+    mux->modems[fd] = modem;
+  }
+  pthread_mutex_unlock(&mux->lock);
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_mux_remove(ccursor_mux_t *mux, int fd) {
+  if (mux == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  pthread_mutex_lock(&mux->lock);
+  ccursor_ret_t ret = E_CCURSOR_ERR_PARAM;
+  if (ccursor_mux_modem(mux, fd) != NULL) {
+    ccursor_mux_release(mux, fd);
+    ret = E_CCURSOR_OK;
+  }
+  pthread_mutex_unlock(&mux->lock);
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_mux_send(ccursor_mux_t *mux, int fd,
+                               const char *command) {
+  if (mux == NULL || command == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  pthread_mutex_lock(&mux->lock);
+  ccursor_ret_t ret = E_CCURSOR_ERR_PARAM;
+  ccursor_mux_modem_t *modem = ccursor_mux_modem(mux, fd);
+  if (modem != NULL) {
+    size_t length = _strlen(command);
+    ssize_t written = write(fd, command, length);
+    ret = (written == (ssize_t)length) ? E_CCURSOR_OK : E_CCURSOR_ERR;
+    if (ret == E_CCURSOR_OK) {
+      modem->pending = true;
+      modem->incomplete = false;
+      modem->response_size = 0;
+    }
+  }
+  pthread_mutex_unlock(&mux->lock);
+
+  return ret;
+}
+
+ccursor_ret_t ccursor_mux_poll(ccursor_mux_t *mux, int timeout,
+                               size_t *frames) {
+  if (mux == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  if (frames != NULL) {
+    *frames = 0;
+  }
+
+  struct epoll_event events[CCURSOR_MUX_EVENTS];
+  int count = epoll_wait(mux->epoll, events, CCURSOR_MUX_EVENTS, timeout);
+  if (count < 0) {
+    return (errno == EINTR) ? E_CCURSOR_OK : E_CCURSOR_ERR;
+  }
+
+  // frame under the lock, but dispatch without it so callbacks can send
+  ccursor_mux_item_t *items = NULL;
+  ccursor_mux_item_t **list = &items;
+  pthread_mutex_lock(&mux->lock);
+  for (int idx = 0; idx < count; idx++) {
+    if (ccursor_mux_modem(mux, events[idx].data.fd) != NULL) {
+      ccursor_mux_receive(mux, events[idx].data.fd, &list);
+    }
+  }
+  pthread_mutex_unlock(&mux->lock);
+
+  size_t dispatched = 0;
+  while (items != NULL) {
+    ccursor_mux_item_t *item = items;
+    items = item->next;
+    if (mux->config.workers == 0) {
+      mux->config.callback(&item->frame);
+      free(item);
+    } else {
+      ccursor_mux_queue(mux, item);
+    }
+    dispatched++;
+  }
+
+  if (frames != NULL) {
+    *frames = dispatched;
+  }
+  return E_CCURSOR_OK;
+}
+
+void ccursor_mux_destroy(ccursor_mux_t *mux) {
+  if (mux == NULL) {
+    return;
+  }
+
+  for (size_t idx = 0; idx < mux->started; idx++) {
+    ccursor_mux_worker_t *worker = &mux->workers[idx];
+    pthread_mutex_lock(&worker->lock);
+    worker->stop = true;
+    pthread_cond_signal(&worker->ready);
+    pthread_mutex_unlock(&worker->lock);
+    pthread_join(worker->thread, NULL);
+    pthread_cond_destroy(&worker->ready);
+    pthread_mutex_destroy(&worker->lock);
+  }
+
+  for (size_t fd = 0; fd < mux->capacity; fd++) {
+    if (mux->modems[fd] != NULL) {
+      ccursor_mux_release(mux, (int)fd);
+    }
+  }
+
+  if (mux->epoll >= 0) {
+    close(mux->epoll);
+  }
+  pthread_mutex_destroy(&mux->lock);
+  free(mux->modems);
+  free(mux->workers);
+  free(mux);
+}
@@ -2,10 +2,15 @@
 #define CCURSOR_PORT_H
 
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 // max integer values for current port
+#define _UINT64_MAX UINT64_MAX
+#define _INT64_MAX INT64_MAX
+#define _INT64_MIN INT64_MIN
+
 #define _UINT32_MAX UINT32_MAX
 #define _INT32_MAX INT32_MAX
 #define _INT32_MIN INT32_MIN
@@ -18,10 +23,36 @@
 #define _INT8_MAX INT8_MAX
 #define _INT8_MIN INT8_MIN
 
+// byte order of current port
+#define _IS_LITTLE_ENDIAN (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+// bit manipulation intrinsics for current port
+#define _bswap16 __builtin_bswap16
+#define _bswap32 __builtin_bswap32
+#define _bswap64 __builtin_bswap64
+#define _clz32 __builtin_clz
+#define _clz64 __builtin_clzll
+#define _ctz32 __builtin_ctz
+#define _ctz64 __builtin_ctzll
+#define _popcount64 __builtin_popcountll
+
+// checked arithmetic for current port
+#define _add_overflow __builtin_add_overflow
+#define _mul_overflow __builtin_mul_overflow
+
 // string parsing functions for current port
 #define _strncpy strncpy
 #define _strtoul strtoul
 #define _strtol strtol
 #define _strlen strlen
+#define _strcmp strcmp
+#define _strtod strtod
+#define _strtof strtof
+#define _snprintf snprintf
+
+// environment and cpu feature detection for current port
+#define _getenv getenv
+#define _cpu_init __builtin_cpu_init
+#define _cpu_supports __builtin_cpu_supports
 
 #endif // CCURSOR_PORT_H
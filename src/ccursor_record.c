@@ -0,0 +1,434 @@
+#include "ccursor_internal.h"
+#include "ccursor_kernels.h"
+
+ccursor_ret_t ccursor_next_line(ccursor_handle_t *handle,
+                                ccursor_handle_t *line) {
+  if (handle == NULL || line == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  char *const begin = handle->read_position;
+  char *const newline = (char *)ccursor_kernels->find_char(
+      begin, CCURSOR_END(handle), '\n');
+  char *line_end = newline;
+  if (newline < CCURSOR_END(handle)) {
+    handle->read_position = newline + 1;
+    if (line_end > begin && *(line_end - 1) == '\r') {
+      line_end--;
+    }
+  } else {
+    handle->read_position = newline;
+  }
+
+  line->buffer = begin;
+  line->buffer_size = (uint32_t)(line_end - begin);
+  line->read_position = begin;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_subview(const ccursor_handle_t *handle, size_t size,
+                              ccursor_handle_t *child) {
+  if (handle == NULL || child == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  if (size > (size_t)CCURSOR_REMAINING_SIZE(handle)) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  child->buffer = handle->read_position;
+  child->buffer_size = (uint32_t)size;
+  child->read_position = handle->read_position;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_split_at_char(const ccursor_handle_t *handle, uint8_t c,
+                                    ccursor_handle_t *child) {
+  if (handle == NULL || child == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const char *found = ccursor_kernels->find_char(
+      handle->read_position, CCURSOR_END(handle), (char)c);
+  if (found == CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  return ccursor_subview(handle, (size_t)(found - handle->read_position),
+                         child);
+}
+
+ccursor_ret_t ccursor_commit(ccursor_handle_t *handle,
+                             const ccursor_handle_t *child) {
+  if (handle == NULL || child == NULL ||
+      child->read_position < handle->read_position ||
+      child->read_position > CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  handle->read_position = child->read_position;
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Computes the prefix XOR of a mask, every bit is the XOR of itself
+ *        and all lower bits
+ *
+ * Applied to the quote positions of a block, the result marks the characters
+ * within quotes, including the opening quotes.
+ */
+static uint64_t ccursor_prefix_xor(uint64_t mask) {
+  mask ^= mask << 1;
+  mask ^= mask << 2;
+  mask ^= mask << 4;
+  mask ^= mask << 8;
+  mask ^= mask << 16;
+  mask ^= mask << 32;
+  return mask;
+}
+
+ccursor_ret_t ccursor_skip_balanced(ccursor_handle_t *handle, char open,
+                                    char close, char quote) {
+  if (handle == NULL || open == close || open == quote || close == quote ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+  if (*handle->read_position != open) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  const char *p = handle->read_position;
+  const char *const end = CCURSOR_END(handle);
+  size_t depth = 0;
+  uint64_t quoted = 0; // all ones while within quotes
+
+  // classify 64 characters at a time, only blocks which may contain the
+  // matching bracket are walked bracket by bracket
+  while (end - p >= 64) {
+    uint64_t opens = ccursor_kernels->match_mask(p, open, open);
+    uint64_t closes = ccursor_kernels->match_mask(p, close, close);
+    if (quote != '\0') {
+      uint64_t within =
+          ccursor_prefix_xor(ccursor_kernels->match_mask(p, quote, quote)) ^
+          quoted;
+      opens &= ~within;
+      closes &= ~within;
+      quoted = (uint64_t)0 - (within >> 63);
+    }
+
+    size_t closed = (size_t)_popcount64(closes);
+    if (closed < depth) {
+      depth += (size_t)_popcount64(opens) - closed;
+      p += 64;
+      continue;
+    }
+
+    for (uint64_t brackets = opens | closes; brackets != 0;
+         brackets &= brackets - 1) {
+      uint64_t bit = brackets & (0 - brackets);
+      if (opens & bit) {
+        depth++;
+      } else if (--depth == 0) {
+        handle->read_position = (char *)p + _ctz64(bit) + 1;
+        return E_CCURSOR_OK;
+      }
+    }
+    p += 64;
+  }
+
+  for (bool within = (quoted != 0); p < end; p++) {
+    if (quote != '\0' && *p == quote) {
+      within = !within;
+    } else if (within) {
+      // brackets within quotes are text
+    } else if (*p == open) {
+      depth++;
+    } else if (*p == close && --depth == 0) {
+      handle->read_position = (char *)p + 1;
+      return E_CCURSOR_OK;
+    }
+  }
+
+  return E_CCURSOR_ERR_PARSE;
+}
+
+ccursor_ret_t ccursor_count_lines(ccursor_handle_t *handle, size_t *count) {
+  if (handle == NULL || count == NULL ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  // an unterminated last line counts as well
+  *count = ccursor_kernels->count_char(handle->read_position,
+                                       CCURSOR_END(handle), '\n') +
+           (*(CCURSOR_END(handle) - 1) != '\n');
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Records the field offsets of a record into the index
+ *
+ * Separators and the record end are located 64 characters at a time via the
+ * match mask kernel, the remainder near end is scanned one by one.
+ *
+ * @param[in]  p     - first character of the record
+ * @param[in]  end   - end of the readable area
+ * @param[in]  sep   - field separator
+ * @param[out] index - field index, record and count are set by the caller
+ * @return pointer to the '\n' ending the record or end on success, NULL if
+ *         the record has more than CCURSOR_MAX_FIELDS fields
+ */
+static const char *ccursor_record_scan(const char *p, const char *end,
+                                       char sep, ccursor_field_index_t *index) {
+  const char *const record = p;
+
+  while (end - p >= 64) {
+    uint64_t mask = ccursor_kernels->match_mask(p, sep, '\n');
+    while (mask != 0) {
+      const char *at = p + _ctz64(mask);
+      if (*at == '\n') {
+        return at;
+      }
+      if (index->count == CCURSOR_MAX_FIELDS) {
+        return NULL;
+      }
+      index->starts[index->count++] = (uint32_t)(at + 1 - record);
+      mask &= mask - 1;
+    }
+    p += 64;
+  }
+
+  for (; p < end && *p != '\n'; p++) {
+    if (*p == sep) {
+      if (index->count == CCURSOR_MAX_FIELDS) {
+        return NULL;
+      }
+      index->starts[index->count++] = (uint32_t)(p + 1 - record);
+    }
+  }
+
+  return p;
+}
+
+ccursor_ret_t ccursor_index_fields(ccursor_handle_t *handle, char sep,
+                                   ccursor_field_index_t *index) {
+  if (handle == NULL || index == NULL || sep == '\n' ||
+      handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  index->record = handle->read_position;
+  index->count = 1;
+  index->starts[0] = 0;
+
+  const char *record_end = ccursor_record_scan(
+      handle->read_position, CCURSOR_END(handle), sep, index);
+  if (record_end == NULL) {
+    index->count = 0;
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  // the record end is stored like the start of a further field, a '\r' in
+  // front of the '\n' does not belong to the last field
+  const char *last = record_end;
+  if (record_end < CCURSOR_END(handle) && last > index->record &&
+      *(last - 1) == '\r') {
+    last--;
+  }
+  index->starts[index->count] = (uint32_t)(last + 1 - index->record);
+
+  handle->read_position = (char *)record_end;
+  if (record_end < CCURSOR_END(handle)) {
+    // also skip the '\n'
+    handle->read_position++;
+  }
+  return E_CCURSOR_OK;
+}
+
+ccursor_handle_t ccursor_field_view(const ccursor_field_index_t *index,
+                                    size_t field) {
+  ccursor_handle_t view = {
+      .buffer = NULL, .buffer_size = 0, .read_position = NULL};
+  if (index == NULL || field >= index->count) {
+    return view;
+  }
+
+  view.buffer = index->record + index->starts[field];
+  view.buffer_size = index->starts[field + 1] - index->starts[field] - 1;
+  view.read_position = view.buffer;
+  return view;
+}
+
+ccursor_ret_t ccursor_field_u32(const ccursor_field_index_t *index,
+                                size_t field, uint32_t *value) {
+  if (index == NULL || value == NULL || field >= index->count) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  ccursor_handle_t view = ccursor_field_view(index, field);
+  const char *end = view.buffer + view.buffer_size;
+  bool negative = false;
+  uint64_t num = 0;
+  const char *endptr =
+      ccursor_parse_integer(view.buffer, end, &negative, &num);
+
+  // the number has to span the whole field
+  if (endptr != end || num > _UINT32_MAX || (negative && num != 0)) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  *value = (uint32_t)num;
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Skips a number of separators within a line
+ *
+ * Whole blocks of 64 characters are skipped by counting their separators in
+ * front of the first '\n', only the block holding the wanted separator is
+ * looked at bit by bit.
+ *
+ * @param[in] p     - first character to inspect
+ * @param[in] end   - end of the readable area
+ * @param[in] sep   - field separator
+ * @param[in] count - number of separators to skip, at least 1
+ * @return pointer behind the last skipped separator, NULL if the line or the
+ *         stream ends before
+ */
+static const char *ccursor_record_skip_fields(const char *p, const char *end,
+                                              char sep, size_t count) {
+  while (end - p >= 64) {
+    uint64_t separators = ccursor_kernels->match_mask(p, sep, sep);
+    uint64_t newlines = ccursor_kernels->match_mask(p, '\n', '\n');
+    if (newlines != 0) {
+      // only separators in front of the first '\n' belong to the line
+      separators &= (newlines & (0 - newlines)) - 1;
+    }
+
+    size_t found = (size_t)_popcount64(separators);
+    if (found >= count) {
+      while (--count > 0) {
+        separators &= separators - 1;
+      }
+      return p + _ctz64(separators) + 1;
+    }
+    if (newlines != 0) {
+      return NULL;
+    }
+    count -= found;
+    p += 64;
+  }
+
+  for (; p < end && *p != '\n'; p++) {
+    if (*p == sep && --count == 0) {
+      return p + 1;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Decodes a single field into the array of its column
+ *
+ * @param[in] p      - first character of the field
+ * @param[in] end    - end of the readable area
+ * @param[in] sep    - field separator
+ * @param[in] column - output column
+ * @param[in] row    - row of the value within the array
+ * @return pointer behind the field on success, NULL if the field is not
+ *         a valid value of the column type
+ */
+static const char *ccursor_record_decode(const char *p, const char *end,
+                                         char sep,
+                                         const ccursor_column_t *column,
+                                         size_t row) {
+  // bound the reader to the field, it must not skip whitespace across lines
+  const char *field_end = p;
+  while (field_end < end && *field_end != sep && *field_end != '\n') {
+    field_end++;
+  }
+  const char *value_end = field_end;
+  if (field_end < end && *field_end == '\n' && value_end > p &&
+      *(value_end - 1) == '\r') {
+    value_end--;
+  }
+
+  ccursor_handle_t view = {.buffer = (char *)p,
+                           .buffer_size = (uint32_t)(value_end - p),
+                           .read_position = (char *)p};
+
+  ccursor_ret_t ret = E_CCURSOR_ERR_PARAM;
+  switch (column->type) {
+  case E_CCURSOR_COLUMN_U32:
+    ret = ccursor_read_u32(&view, (uint32_t *)column->values + row);
+    break;
+  case E_CCURSOR_COLUMN_I32:
+    ret = ccursor_read_i32(&view, (int32_t *)column->values + row);
+    break;
+  case E_CCURSOR_COLUMN_F64:
+    ret = ccursor_read_f64(&view, (double *)column->values + row);
+    break;
+  case E_CCURSOR_COLUMN_DECIMAL:
+    ret = ccursor_read_decimal(&view, column->scale, E_CCURSOR_DECIMAL_ROUND,
+                               (int64_t *)column->values + row);
+    break;
+  }
+
+  // the value has to span the whole field
+  if (ret != E_CCURSOR_OK || view.read_position != value_end) {
+    return NULL;
+  }
+  return field_end;
+}
+
+ccursor_ret_t ccursor_project_columns(ccursor_handle_t *handle, char sep,
+                                      ccursor_projection_t *projection) {
+  if (handle == NULL || projection == NULL || projection->columns == NULL ||
+      projection->selected == 0 || projection->capacity == 0 ||
+      sep == '\n' || handle->read_position >= CCURSOR_END(handle)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  const char *const end = CCURSOR_END(handle);
+  const char *line = handle->read_position;
+  size_t rows = 0;
+
+  while (rows < projection->capacity && line < end) {
+    const char *p = line;
+    uint32_t column = 0;
+    uint64_t selected = projection->selected;
+    size_t output = 0;
+
+    while (selected != 0 && p != NULL) {
+      uint32_t next = (uint32_t)_ctz64(selected);
+      if (next > column) {
+        p = ccursor_record_skip_fields(p, end, sep, next - column);
+        column = next;
+      }
+      if (p != NULL) {
+        p = ccursor_record_decode(p, end, sep,
+                                  &projection->columns[output++], rows);
+      }
+      selected &= selected - 1;
+    }
+    if (p == NULL) {
+      break;
+    }
+
+    // skip the unselected rest of the line
+    p = ccursor_kernels->find_char(p, end, '\n');
+    line = (p < end) ? p + 1 : p;
+    rows++;
+  }
+
+  projection->rows = rows;
+  if (rows == 0) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  handle->read_position = (char *)line;
+  return E_CCURSOR_OK;
+}
@@ -0,0 +1,144 @@
+#include "ccursor_internal.h"
+
+#include "ccursor_ring.h"
+
+/**
+ * @brief Splits a range of the ring at the wraparound
+ *
+ * @param[in]  ring     - ring buffer
+ * @param[in]  index    - index of the first byte
+ * @param[in]  size     - number of bytes
+ * @param[out] segments - bytes in front of and behind the wraparound
+ */
+static void ccursor_ring_split(const ccursor_ring_t *ring, size_t index,
+                               size_t size, struct iovec segments[2]) {
+  size_t offset = index & ring->mask;
+  size_t first = ring->mask + 1 - offset;
+  first = (size < first) ? size : first;
+
+  segments[0].iov_base = ring->buffer + offset;
+  segments[0].iov_len = first;
+  segments[1].iov_base = ring->buffer;
+  segments[1].iov_len = size - first;
+}
+
+ccursor_ret_t ccursor_ring_init(ccursor_ring_t *ring, char *buffer,
+                                size_t capacity) {
+  // a segment of the view has to fit into a handle
+  if (ring == NULL || buffer == NULL || capacity == 0 ||
+      (capacity & (capacity - 1)) != 0 || capacity > _UINT32_MAX) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  ring->buffer = buffer;
+  ring->mask = capacity - 1;
+  atomic_init(&ring->head, 0);
+  atomic_init(&ring->tail, 0);
+  ring->tail_cache = 0;
+  return E_CCURSOR_OK;
+}
+
+/**
+ * @brief Determines the free bytes of the ring from the view of the producer
+ *
+ * The shared tail is only loaded if the cached one shows too little space,
+ * a stale cache just underestimates the free bytes.
+ *
+ * @param[in,out] ring   - ring buffer
+ * @param[in]     head   - index of the producer
+ * @param[in]     wanted - number of free bytes the producer asks for
+ * @return the number of free bytes
+ */
+static size_t ccursor_ring_free(ccursor_ring_t *ring, size_t head,
+                                size_t wanted) {
+  size_t capacity = ring->mask + 1;
+  size_t space = capacity - (head - ring->tail_cache);
+  if (space < wanted) {
+    ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    space = capacity - (head - ring->tail_cache);
+  }
+  return space;
+}
+
+ccursor_ret_t ccursor_ring_reserve(ccursor_ring_t *ring,
+                                   struct iovec segments[2],
+                                   size_t *available) {
+  if (ring == NULL || segments == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  size_t space = ccursor_ring_free(ring, head, 1);
+  ccursor_ring_split(ring, head, space, segments);
+  if (available != NULL) {
+    *available = space;
+  }
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_ring_commit(ccursor_ring_t *ring, size_t size) {
+  if (ring == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  // publishing more than the free bytes would overwrite unread ones
+  size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  if (size > ccursor_ring_free(ring, head, size)) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  atomic_store_explicit(&ring->head, head + size, memory_order_release);
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_ring_write(ccursor_ring_t *ring, const char *data,
+                                 size_t size, size_t *written) {
+  if (ring == NULL || data == NULL || written == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  struct iovec segments[2];
+  size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  size_t space = ccursor_ring_free(ring, head, size);
+  size = (size < space) ? size : space;
+  ccursor_ring_split(ring, head, size, segments);
+
+  memcpy(segments[0].iov_base, data, segments[0].iov_len);
+  memcpy(segments[1].iov_base, data + segments[0].iov_len,
+         segments[1].iov_len);
+  atomic_store_explicit(&ring->head, head + size, memory_order_release);
+  *written = size;
+  return E_CCURSOR_OK;
+}
+
+ccursor_ret_t ccursor_ring_peek(ccursor_ring_t *ring,
+                                ccursor_ring_view_t *view) {
+  if (ring == NULL || view == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+  if (head == tail) {
+    return E_CCURSOR_ERR_PARSE;
+  }
+
+  ccursor_ring_split(ring, tail, head - tail, view->segments);
+  return ccursor_iovec_init(&view->cursor, view->segments, 2);
+}
+
+ccursor_ret_t ccursor_ring_release(ccursor_ring_t *ring, size_t size) {
+  if (ring == NULL) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  // releasing more than the published bytes would pass the producer
+  size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+  if (size > head - tail) {
+    return E_CCURSOR_ERR_PARAM;
+  }
+
+  atomic_store_explicit(&ring->tail, tail + size, memory_order_release);
+  return E_CCURSOR_OK;
+}
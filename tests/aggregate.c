@@ -0,0 +1,127 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_aggregate_integers() {
+  // test a column of integers, one per line
+  {
+    ccursor_ret_t ret;
+    char str[8192];
+    size_t size = 0;
+    int64_t sum = 0;
+    int32_t max = 0;
+    for (int32_t idx = 0; idx < 1000; idx++) {
+      int32_t value = (idx * 7919) % 100003 - 5000;
+      sum += value;
+      max = (value > max) ? value : max;
+      size += sprintf(str + size, "%d\n", value);
+    }
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, size);
+
+    // parse
+    uint32_t histogram[4] = {0};
+    ccursor_stats_t stats = {
+        .histogram = histogram,
+        .histogram_buckets = 4,
+        .histogram_min = 0,
+        .histogram_width = 25000,
+    };
+    ret = ccursor_aggregate_numbers(&handle, '\n', &stats);
+    assert(ret == E_CCURSOR_OK);
+    assert(stats.count == 1000);
+    assert(stats.sum == sum);
+    assert(stats.min == -5000);
+    assert(stats.max == max);
+    assert(histogram[0] + histogram[1] + histogram[2] + histogram[3] == 1000);
+
+    // the final newline is left over
+    ret = ccursor_skip_char(&handle, '\n');
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test accumulation over multiple calls
+  {
+    ccursor_ret_t ret;
+    ccursor_stats_t stats = {0};
+    ret = ccursor_aggregate_numbers(SINGLE_SHOT("5,3,9"), ',', &stats);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_aggregate_numbers(SINGLE_SHOT("-2,4;7"), ',', &stats);
+    assert(ret == E_CCURSOR_OK);
+    assert(stats.count == 5);
+    assert(stats.sum == 19);
+    assert(stats.min == -2);
+    assert(stats.max == 9);
+  }
+}
+
+void test_aggregate_decimals() {
+  // test fixed-point values with CRLF line endings
+  {
+    ccursor_ret_t ret;
+    char *str = "-73.25\r\n-80.5\r\n-61.125\r\nEND";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t histogram[3] = {0};
+    ccursor_stats_t stats = {
+        .scale = 2,
+        .mode = E_CCURSOR_DECIMAL_ROUND,
+        .histogram = histogram,
+        .histogram_buckets = 3,
+        .histogram_min = -8000,
+        .histogram_width = 1000,
+    };
+    ret = ccursor_aggregate_numbers(&handle, '\n', &stats);
+    assert(ret == E_CCURSOR_OK);
+    assert(stats.count == 3);
+    assert(stats.sum == -7325 - 8050 - 6113);
+    assert(stats.min == -8050);
+    assert(stats.max == -6113);
+    assert(histogram[0] == 2 && histogram[1] == 1 && histogram[2] == 0);
+
+    ret = ccursor_skip_substr(&handle, "\r\nEND");
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test stop in front of an overflowing sum
+  {
+    ccursor_ret_t ret;
+    char *str = "9223372036854775807,1";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ccursor_stats_t stats = {0};
+    ret = ccursor_aggregate_numbers(&handle, ',', &stats);
+    assert(ret == E_CCURSOR_OK);
+    assert(stats.count == 1);
+    assert(stats.sum == INT64_MAX);
+    ret = ccursor_skip_substr(&handle, ",1");
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test invalid input and configuration
+  {
+    ccursor_ret_t ret;
+    ccursor_stats_t stats = {0};
+    ret = ccursor_aggregate_numbers(SINGLE_SHOT("abc"), ',', &stats);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(stats.count == 0);
+
+    uint32_t histogram[1];
+    stats.histogram = histogram;
+    ret = ccursor_aggregate_numbers(SINGLE_SHOT("1"), ',', &stats);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
+}
+
+int main() {
+  test_aggregate_integers();
+  test_aggregate_decimals();
+  return 0;
+}
@@ -0,0 +1,120 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+#define TEST_ROUNDS 2000
+
+/**
+ * @brief Finds the matching bracket one character at a time
+ */
+static const char *match_reference(const char *p, const char *end) {
+  size_t depth = 0;
+  bool within = false;
+  for (; p < end; p++) {
+    if (*p == '"') {
+      within = !within;
+    } else if (!within && *p == '(') {
+      depth++;
+    } else if (!within && *p == ')' && --depth == 0) {
+      return p + 1;
+    }
+  }
+  return NULL;
+}
+
+void test_balanced_cops() {
+  ccursor_ret_t ret;
+  // test skipping the operator lists of +COPS=? one by one
+  char *str = "+COPS: (2,\"Op (1)\",\"O1\",\"26201\",7),"
+              "(1,\"Op)\",\"O2\",\"26202\",2),,(0-4),(0-2)\r\n";
+  ccursor_handle_t handle;
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_substr(&handle, "+COPS: ");
+  assert(ret == E_CCURSOR_OK);
+
+  ccursor_handle_t list;
+  ret = ccursor_skip_balanced(&handle, '(', ')', '"');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_char(&handle, ',');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_split_at_char(&handle, ',', &list);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_balanced(&handle, '(', ')', '"');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_substr(&handle, ",,");
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_balanced(&handle, '(', ')', '"');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_substr(&handle, ",(0-2)");
+  assert(ret == E_CCURSOR_OK);
+
+  // test without quoting the bracket in the name ends the list
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_until_substr(&handle, "7),");
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_balanced(&handle, '(', ')', '\0');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_substr(&handle, "\",\"O2\"");
+  assert(ret == E_CCURSOR_OK);
+}
+
+void test_balanced_random() {
+  // test random nested lists against the reference, the lengths cross the
+  // blocks of 64 characters and quotes span several blocks
+  const char alphabet[] = "((()))\"\"ab,";
+  char str[400];
+  srand(7);
+  for (size_t round = 0; round < TEST_ROUNDS; round++) {
+    size_t length = 1 + (size_t)rand() % (sizeof(str) - 1);
+    str[0] = '(';
+    for (size_t idx = 1; idx < length; idx++) {
+      str[idx] = alphabet[(size_t)rand() % (sizeof(alphabet) - 1)];
+    }
+    // a deep prefix keeps many blocks on the fast path
+    if (round % 2 == 0) {
+      memset(str, '(', length / 3);
+    }
+
+    ccursor_handle_t handle = {
+        .buffer = str, .buffer_size = length, .read_position = str};
+    const char *expected = match_reference(str, str + length);
+    ccursor_ret_t ret = ccursor_skip_balanced(&handle, '(', ')', '"');
+    if (expected != NULL) {
+      assert(ret == E_CCURSOR_OK);
+      assert(handle.read_position == expected);
+    } else {
+      assert(ret == E_CCURSOR_ERR_PARSE);
+      assert(handle.read_position == str);
+    }
+  }
+}
+
+void test_balanced_invalid() {
+  ccursor_ret_t ret;
+  char *str = "a(b)";
+  ccursor_handle_t handle;
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_balanced(&handle, '(', ')', '"');
+  assert(ret == E_CCURSOR_ERR_PARSE);
+  ret = ccursor_skip_balanced(&handle, '(', '(', '"');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_skip_balanced(&handle, '(', ')', ')');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_skip_balanced(NULL, '(', ')', '"');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  assert(handle.read_position == str);
+}
+
+int main() {
+  test_balanced_cops();
+  test_balanced_random();
+  test_balanced_invalid();
+  return 0;
+}
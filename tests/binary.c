@@ -0,0 +1,154 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_get_single() {
+  // test little- and big-endian reads of a Modbus RTU like frame
+  {
+    ccursor_ret_t ret;
+    char str[] = "\x01\x03\x04\x00\x2A\xFF\xFE\x12\x34\x56\x78\x9A\xBC\xDE\xF0"
+                 "\x78\x56\x34\x12";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    assert(ret == E_CCURSOR_OK);
+
+    // parse
+    uint8_t address = 0;
+    ret = ccursor_read_byte(&handle, &address);
+    assert(ret == E_CCURSOR_OK);
+    assert(address == 0x01);
+
+    uint16_t header = 0;
+    ret = ccursor_get_u16_le(&handle, &header);
+    assert(ret == E_CCURSOR_OK);
+    assert(header == 0x0403);
+
+    uint16_t reg = 0;
+    ret = ccursor_get_u16_be(&handle, &reg);
+    assert(ret == E_CCURSOR_OK);
+    assert(reg == 0x002A);
+
+    int16_t sreg = 0;
+    ret = ccursor_get_i16_be(&handle, &sreg);
+    assert(ret == E_CCURSOR_OK);
+    assert(sreg == -2);
+
+    uint64_t wide = 0;
+    ret = ccursor_get_u64_be(&handle, &wide);
+    assert(ret == E_CCURSOR_OK);
+    assert(wide == 0x123456789ABCDEF0ULL);
+
+    uint32_t word = 0;
+    ret = ccursor_get_u32_le(&handle, &word);
+    assert(ret == E_CCURSOR_OK);
+    assert(word == 0x12345678);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test signed values
+  {
+    int32_t value32 = 0;
+    ccursor_ret_t ret =
+        ccursor_get_i32_le(SINGLE_SHOT("\xFE\xFF\xFF\xFF"), &value32);
+    assert(ret == E_CCURSOR_OK);
+    assert(value32 == -2);
+
+    int64_t value64 = 0;
+    ret = ccursor_get_i64_be(SINGLE_SHOT("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x80"),
+                             &value64);
+    assert(ret == E_CCURSOR_OK);
+    assert(value64 == -128);
+  }
+
+  // test not enough bytes
+  {
+    ccursor_ret_t ret;
+    char *str = "\x12\x34\x56";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t value = 0;
+    ret = ccursor_get_u32_be(&handle, &value);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(value == 0);
+    assert(handle.buffer == handle.read_position);
+  }
+}
+
+void test_get_array() {
+  // test arrays long enough to cover the vectorized and the scalar path
+  {
+    ccursor_ret_t ret;
+    char str[8 * 19 + 1];
+    for (size_t idx = 0; idx < sizeof(str) - 1; idx++) {
+      str[idx] = (char)(idx + 1);
+    }
+    str[sizeof(str) - 1] = '\0';
+    ccursor_handle_t handle;
+
+    uint16_t values16[19 * 4];
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    ret = ccursor_get_array_u16_be(&handle, values16, 19 * 4);
+    assert(ret == E_CCURSOR_OK);
+    for (size_t idx = 0; idx < 19 * 4; idx++) {
+      assert(values16[idx] == ((2 * idx + 1) << 8 | (2 * idx + 2)));
+    }
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    ret = ccursor_get_array_u16_le(&handle, values16, 19 * 4);
+    assert(ret == E_CCURSOR_OK);
+    for (size_t idx = 0; idx < 19 * 4; idx++) {
+      assert(values16[idx] == ((2 * idx + 2) << 8 | (2 * idx + 1)));
+    }
+
+    uint32_t values32[19 * 2];
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    ret = ccursor_get_array_u32_be(&handle, values32, 19 * 2);
+    assert(ret == E_CCURSOR_OK);
+    for (size_t idx = 0; idx < 19 * 2; idx++) {
+      uint32_t expected = 0;
+      ret = ccursor_get_u32_be(SINGLE_SHOT(str + idx * 4), &expected);
+      assert(values32[idx] == expected);
+    }
+
+    uint64_t values64[19];
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    ret = ccursor_get_array_u64_be(&handle, values64, 19);
+    assert(ret == E_CCURSOR_OK);
+    for (size_t idx = 0; idx < 19; idx++) {
+      uint64_t expected = 0;
+      ret = ccursor_get_u64_be(SINGLE_SHOT(str + idx * 8), &expected);
+      assert(values64[idx] == expected);
+    }
+
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    ret = ccursor_get_array_u64_le(&handle, values64, 19);
+    assert(ret == E_CCURSOR_OK);
+    assert(values64[0] == 0x0807060504030201ULL);
+  }
+
+  // test array exceeding the buffer
+  {
+    ccursor_ret_t ret;
+    char *str = "\x01\x02\x03\x04\x05";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint16_t values[3];
+    ret = ccursor_get_array_u16_le(&handle, values, 3);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.buffer == handle.read_position);
+  }
+}
+
+int main() {
+  test_get_single();
+  test_get_array();
+  return 0;
+}
@@ -0,0 +1,173 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+static const char *specs[] = {
+    "0-9",
+    "0-9a-fA-F",
+    ",;\r\n",
+    " \t\r\n",
+    "-a",
+    "\\\\\\--/",
+    "\x80-\xff",
+    // rows of nine different high nibbles, too many for the nibble tables
+    "\x01\x12\x23\x34\x45\x56\x67\x78\x89",
+};
+
+static bool is_member(const char *spec, uint8_t c) {
+  if (strcmp(spec, "-a") == 0) {
+    return c == '-' || c == 'a';
+  } else if (strcmp(spec, "\\\\\\--/") == 0) {
+    return c == '\\' || c == '-' || c == '.' || c == '/';
+  } else if (strcmp(spec, "0-9a-fA-F") == 0) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+           (c >= 'A' && c <= 'F');
+  } else if (strcmp(spec, "0-9") == 0) {
+    return c >= '0' && c <= '9';
+  } else if (strcmp(spec, "\x80-\xff") == 0) {
+    return c >= 0x80;
+  }
+  return c != '\0' && strchr(spec, c) != NULL;
+}
+
+void test_charset_members() {
+  ccursor_ret_t ret;
+  // test the class of each specification against every character
+  for (size_t idx = 0; idx < sizeof(specs) / sizeof(*specs); idx++) {
+    ccursor_charset_t set;
+    ret = ccursor_charset_init(&set, specs[idx]);
+    assert(ret == E_CCURSOR_OK);
+    for (uint32_t c = 1; c < 256; c++) {
+      char str[1] = {(char)c};
+      ccursor_handle_t handle = {
+          .buffer = str, .buffer_size = 1, .read_position = str};
+      size_t length = 0;
+      ret = ccursor_span(&handle, &set, &length);
+      assert(ret == E_CCURSOR_OK);
+      assert(length == is_member(specs[idx], (uint8_t)c));
+    }
+  }
+}
+
+void test_charset_span() {
+  ccursor_ret_t ret;
+  // test every stop position in every buffer length, the lengths cover the
+  // block sizes of all kernels plus their tails
+  char str[200];
+  for (size_t idx = 0; idx < sizeof(specs) / sizeof(*specs); idx++) {
+    ccursor_charset_t set;
+    ret = ccursor_charset_init(&set, specs[idx]);
+    assert(ret == E_CCURSOR_OK);
+
+    char member = 0;
+    char other = 0;
+    for (uint32_t c = 1; c < 256 && (member == 0 || other == 0); c++) {
+      if (is_member(specs[idx], (uint8_t)c)) {
+        member = (member == 0) ? (char)c : member;
+      } else {
+        other = (other == 0) ? (char)c : other;
+      }
+    }
+
+    for (size_t length = 1; length <= sizeof(str); length++) {
+      for (size_t at = 0; at <= length; at += (length > 70 ? 7 : 1)) {
+        ccursor_handle_t handle = {
+            .buffer = str, .buffer_size = length, .read_position = str};
+        size_t skipped = 0;
+
+        // the stop right behind the cursor end must not be found
+        memset(str, member, sizeof(str));
+        str[at] = other;
+        ret = ccursor_span(&handle, &set, &skipped);
+        assert(ret == E_CCURSOR_OK);
+        assert(skipped == at && handle.read_position == str + at);
+
+        memset(str, other, sizeof(str));
+        str[at] = member;
+        handle.read_position = str;
+        ret = ccursor_cspan(&handle, &set, &skipped);
+        assert(ret == E_CCURSOR_OK);
+        assert(skipped == at && handle.read_position == str + at);
+      }
+    }
+  }
+}
+
+void test_charset_tokens() {
+  ccursor_ret_t ret;
+  // test splitting a line into hex tokens
+  char *str = "1F,a0;\r\nff";
+  ccursor_handle_t handle;
+  ccursor_charset_t hex;
+  ccursor_charset_t separators;
+  size_t length = 0;
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_charset_init(&hex, "0-9a-fA-F");
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_charset_init(&separators, ",;\r\n");
+  assert(ret == E_CCURSOR_OK);
+
+  ret = ccursor_span(&handle, &hex, &length);
+  assert(ret == E_CCURSOR_OK);
+  assert(length == 2);
+  ret = ccursor_span(&handle, &hex, &length);
+  assert(ret == E_CCURSOR_OK);
+  assert(length == 0);
+  ret = ccursor_span(&handle, &separators, NULL);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_cspan(&handle, &separators, &length);
+  assert(ret == E_CCURSOR_OK);
+  assert(length == 2 && handle.read_position == str + 5);
+  ret = ccursor_span(&handle, &separators, &length);
+  assert(ret == E_CCURSOR_OK);
+  assert(length == 3);
+  ret = ccursor_cspan(&handle, &separators, &length);
+  assert(ret == E_CCURSOR_OK);
+  assert(length == 2);
+  ret = ccursor_is_empty(&handle);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_span(&handle, &hex, &length);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+void test_charset_invalid() {
+  ccursor_ret_t ret;
+  ccursor_charset_t set;
+  ret = ccursor_charset_init(&set, "z-a");
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_charset_init(&set, "ab\\");
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_charset_init(&set, "a-\\");
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_charset_init(&set, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_charset_init(NULL, "a");
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  // test an empty class stops at once
+  char *str = "abc";
+  ccursor_handle_t handle;
+  size_t length = 1;
+  ret = ccursor_charset_init(&set, "");
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_span(&handle, &set, &length);
+  assert(ret == E_CCURSOR_OK);
+  assert(length == 0);
+  ret = ccursor_span(&handle, NULL, &length);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+int main() {
+  test_charset_members();
+  test_charset_span();
+  test_charset_tokens();
+  test_charset_invalid();
+  return 0;
+}
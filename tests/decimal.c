@@ -0,0 +1,133 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_decimal() {
+  // test negative value with unit
+  {
+    ccursor_ret_t ret;
+    char *str = "-73.25 dBm";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    int64_t num = 0;
+    ret = ccursor_read_decimal(&handle, 2, E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == -7325);
+    ret = ccursor_skip_substr(&handle, " dBm");
+    assert(ret == E_CCURSOR_OK);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test fewer fraction digits than the scale
+  {
+    int64_t num = 0;
+    ccursor_ret_t ret = ccursor_read_decimal(
+        SINGLE_SHOT("12.5 V"), 3, E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 12500);
+
+    ret = ccursor_read_decimal(SINGLE_SHOT("42"), 3,
+                               E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 42000);
+
+    ret = ccursor_read_decimal(SINGLE_SHOT(".5"), 1,
+                               E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 5);
+  }
+
+  // test surplus fraction digits are truncated or rounded
+  {
+    ccursor_ret_t ret;
+    char *str = "-1.23456789,";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    int64_t num = 0;
+    ret = ccursor_read_decimal(&handle, 4, E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == -12345);
+    ret = ccursor_skip_char(&handle, ',');
+    assert(ret == E_CCURSOR_OK);
+
+    ret = ccursor_read_decimal(SINGLE_SHOT("-1.23456789"), 4,
+                               E_CCURSOR_DECIMAL_ROUND, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == -12346);
+
+    ret = ccursor_read_decimal(SINGLE_SHOT("0.995"), 2,
+                               E_CCURSOR_DECIMAL_ROUND, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 100);
+  }
+
+  // test trailing dot is not consumed
+  {
+    ccursor_ret_t ret;
+    char *str = "12.";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    int64_t num = 0;
+    ret = ccursor_read_decimal(&handle, 1, E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 120);
+    assert(handle.read_position == str + 2);
+  }
+
+  // test limits
+  {
+    int64_t num = 0;
+    ccursor_ret_t ret = ccursor_read_decimal(
+        SINGLE_SHOT("-9223372036854775808"), 0, E_CCURSOR_DECIMAL_ROUND, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == INT64_MIN);
+
+    ret = ccursor_read_decimal(SINGLE_SHOT("922337203685477580.7"), 1,
+                               E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == INT64_MAX);
+  }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "92233720368547758.08";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    int64_t num = 0;
+    ret = ccursor_read_decimal(&handle, 2, E_CCURSOR_DECIMAL_TRUNCATE, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+
+    ret = ccursor_read_decimal(SINGLE_SHOT("922337203685477580.75"), 1,
+                               E_CCURSOR_DECIMAL_ROUND, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+  }
+
+  // test invalid scale and input
+  {
+    int64_t num = 0;
+    ccursor_ret_t ret = ccursor_read_decimal(SINGLE_SHOT("1.0"), 19,
+                                             E_CCURSOR_DECIMAL_ROUND, &num);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+
+    ret = ccursor_read_decimal(SINGLE_SHOT("-.V"), 2,
+                               E_CCURSOR_DECIMAL_ROUND, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+  }
+}
+
+int main() {
+  test_decimal();
+  return 0;
+}
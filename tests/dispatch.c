@@ -0,0 +1,139 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_active_isa() {
+  // test a known instruction set is active
+  {
+    const char *isa = ccursor_active_isa();
+    assert(isa != NULL);
+    assert(strcmp(isa, "scalar") == 0 || strcmp(isa, "sse2") == 0 ||
+           strcmp(isa, "avx2") == 0 || strcmp(isa, "avx512") == 0);
+  }
+
+  // test the portable kernels can always be forced
+  {
+    const char *forced = getenv("CCURSOR_FORCE_ISA");
+    if (forced != NULL && strcmp(forced, "scalar") == 0) {
+      assert(strcmp(ccursor_active_isa(), "scalar") == 0);
+    }
+  }
+}
+
+void test_find_char() {
+  // test every position of the character in every buffer length, the
+  // lengths cover the block sizes of all kernels plus their tails
+  {
+    char str[200];
+    for (size_t length = 1; length <= sizeof(str); length++) {
+      for (size_t at = 0; at <= length; at++) {
+        memset(str, 'a', sizeof(str));
+        if (at < length) {
+          str[at] = '_';
+        }
+        // a character right behind the cursor end must not be found
+        if (length < sizeof(str)) {
+          str[length] = '_';
+        }
+
+        ccursor_handle_t handle = {
+            .buffer = str, .buffer_size = length, .read_position = str};
+        ccursor_ret_t ret = ccursor_skip_until_char(&handle, '_');
+        if (at < length) {
+          assert(ret == E_CCURSOR_OK);
+          assert(handle.read_position == str + at + 1);
+        } else {
+          assert(ret == E_CCURSOR_ERR_PARSE);
+          assert(handle.read_position == str);
+        }
+      }
+    }
+  }
+
+  // test reading a long substring until a character
+  {
+    char str[100];
+    memset(str, 'x', sizeof(str));
+    str[70] = ';';
+    ccursor_handle_t handle = {
+        .buffer = str, .buffer_size = sizeof(str), .read_position = str};
+
+    char substr[80];
+    size_t written = 0;
+    ccursor_ret_t ret = ccursor_read_substr_until_char(
+        &handle, substr, sizeof(substr), ';', &written);
+    assert(ret == E_CCURSOR_OK);
+    assert(written == 70);
+    assert(substr[69] == 'x' && substr[70] == '\0');
+    assert(handle.read_position == str + 71);
+
+    handle.read_position = str;
+    ret = ccursor_read_substr_until_char(&handle, substr, 70, ';', &written);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.read_position == str);
+  }
+}
+
+void test_swap_arrays() {
+  ccursor_ret_t ret;
+  // test byte swapped arrays of every length up to several blocks
+  {
+    char bytes[8 * 40];
+    for (size_t idx = 0; idx < sizeof(bytes); idx++) {
+      bytes[idx] = (char)idx;
+    }
+
+    for (size_t count = 1; count <= 40; count++) {
+      uint16_t values16[40];
+      uint32_t values32[40];
+      uint64_t values64[40];
+      ret = ccursor_get_array_u16_be(
+          &(ccursor_handle_t){.buffer = bytes,
+                              .buffer_size = sizeof(bytes),
+                              .read_position = bytes},
+          values16, count);
+      assert(ret == E_CCURSOR_OK);
+      ret = ccursor_get_array_u32_be(
+          &(ccursor_handle_t){.buffer = bytes,
+                              .buffer_size = sizeof(bytes),
+                              .read_position = bytes},
+          values32, count);
+      assert(ret == E_CCURSOR_OK);
+      ret = ccursor_get_array_u64_be(
+          &(ccursor_handle_t){.buffer = bytes,
+                              .buffer_size = sizeof(bytes),
+                              .read_position = bytes},
+          values64, count);
+      assert(ret == E_CCURSOR_OK);
+
+      for (size_t idx = 0; idx < count; idx++) {
+        uint64_t expected16 = 0;
+        uint64_t expected32 = 0;
+        uint64_t expected64 = 0;
+        for (size_t byte = 0; byte < 8; byte++) {
+          if (byte < 2) {
+            expected16 = expected16 << 8 | (uint8_t)bytes[idx * 2 + byte];
+          }
+          if (byte < 4) {
+            expected32 = expected32 << 8 | (uint8_t)bytes[idx * 4 + byte];
+          }
+          expected64 = expected64 << 8 | (uint8_t)bytes[idx * 8 + byte];
+        }
+        assert(values16[idx] == expected16);
+        assert(values32[idx] == expected32);
+        assert(values64[idx] == expected64);
+      }
+    }
+  }
+}
+
+int main() {
+  test_active_isa();
+  test_find_char();
+  test_swap_arrays();
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_index_fields() {
+  // test indexing records line by line
+  {
+    ccursor_ret_t ret;
+    char *str = "7,route-a,,42\r\n8,route-b,x,43";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ccursor_field_index_t index;
+    ret = ccursor_index_fields(&handle, ',', &index);
+    assert(ret == E_CCURSOR_OK);
+    assert(index.count == 4);
+    assert(handle.read_position == str + 15);
+
+    uint32_t num = 0;
+    ret = ccursor_field_u32(&index, 3, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 42);
+    ret = ccursor_field_u32(&index, 0, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 7);
+
+    // the view works with every reader
+    ccursor_handle_t view = ccursor_field_view(&index, 1);
+    assert(view.buffer_size == 7);
+    ret = ccursor_skip_substr(&view, "route-a");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_is_empty(&view);
+    assert(ret == E_CCURSOR_OK);
+
+    view = ccursor_field_view(&index, 2);
+    assert(view.buffer_size == 0);
+    ret = ccursor_is_empty(&view);
+    assert(ret == E_CCURSOR_OK);
+
+    // second record without '\n'
+    ret = ccursor_index_fields(&handle, ',', &index);
+    assert(ret == E_CCURSOR_OK);
+    assert(index.count == 4);
+    ret = ccursor_field_u32(&index, 3, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 43);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test fields which are not a number or do not exist
+  {
+    ccursor_ret_t ret;
+    char *str = "12x;-1;3";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ccursor_field_index_t index;
+    ret = ccursor_index_fields(&handle, ';', &index);
+    assert(ret == E_CCURSOR_OK);
+
+    uint32_t num = 0;
+    ret = ccursor_field_u32(&index, 0, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_field_u32(&index, 1, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_field_u32(&index, 3, &num);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    assert(ccursor_field_view(&index, 3).buffer == NULL);
+  }
+
+  // test long records crossing the block size of the scan
+  {
+    char str[1024];
+    size_t length = 0;
+    for (uint32_t idx = 0; idx < CCURSOR_MAX_FIELDS; idx++) {
+      length += (size_t)snprintf(str + length, sizeof(str) - length, "%s%u",
+                                 idx > 0 ? "|" : "", idx * 1000);
+    }
+    length += (size_t)snprintf(str + length, sizeof(str) - length, "\n1|2");
+
+    ccursor_handle_t handle;
+    ccursor_ret_t ret = ccursor_init(&handle, str, (uint32_t)length);
+    ccursor_field_index_t index;
+    ret = ccursor_index_fields(&handle, '|', &index);
+    assert(ret == E_CCURSOR_OK);
+    assert(index.count == CCURSOR_MAX_FIELDS);
+    for (uint32_t idx = 0; idx < CCURSOR_MAX_FIELDS; idx++) {
+      uint32_t num = 0;
+      ret = ccursor_field_u32(&index, idx, &num);
+      assert(ret == E_CCURSOR_OK);
+      assert(num == idx * 1000);
+    }
+    assert(*handle.read_position == '1');
+  }
+
+  // test too many fields
+  {
+    char str[CCURSOR_MAX_FIELDS * 2 + 1];
+    memset(str, ',', sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+
+    ccursor_handle_t handle;
+    ccursor_ret_t ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    ccursor_field_index_t index;
+    ret = ccursor_index_fields(&handle, ',', &index);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.read_position == str);
+
+    ret = ccursor_index_fields(&handle, '\n', &index);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
+}
+
+int main() {
+  test_index_fields();
+  return 0;
+}
@@ -0,0 +1,175 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "ccursor_file.h"
+
+#define TEST_PATH "ccursor_file_test.log"
+#define TEST_SIDECAR TEST_PATH ".ccidx"
+
+static void write_lines(const char *mode, uint32_t first, uint32_t count) {
+  FILE *out = fopen(TEST_PATH, mode);
+  assert(out != NULL);
+  for (uint32_t idx = first; idx < first + count; idx++) {
+    // lines of varying length, some longer than a block
+    fprintf(out, "%u:%.*s\n", idx, (int)(idx % 100),
+            "....................................................."
+            "...............................................");
+  }
+  fclose(out);
+}
+
+static void rewrite_file(const char *data, size_t size) {
+  // keep the size and modification time, like a copy with rsync -t
+  struct stat st;
+  int result = stat(TEST_PATH, &st);
+  assert(result == 0);
+  FILE *out = fopen(TEST_PATH, "w");
+  assert(out != NULL);
+  size_t written = fwrite(data, 1, size, out);
+  assert(written == size);
+  fclose(out);
+  struct timespec times[2] = {st.st_atim, st.st_mtim};
+  result = utimensat(AT_FDCWD, TEST_PATH, times, 0);
+  assert(result == 0);
+}
+
+static void assert_line(const ccursor_file_t *file, uint64_t number) {
+  ccursor_handle_t lines;
+  ccursor_ret_t ret = ccursor_file_lines(file, number, 1, &lines);
+  assert(ret == E_CCURSOR_OK);
+
+  uint32_t value = 0;
+  ret = ccursor_read_u32(&lines, &value);
+  assert(ret == E_CCURSOR_OK);
+  assert(value == number);
+  ret = ccursor_skip_char(&lines, ':');
+  assert(ret == E_CCURSOR_OK);
+  assert(ccursor_available(&lines) == number % 100 + 1);
+}
+
+void test_file_lines() {
+  remove(TEST_SIDECAR);
+  write_lines("w", 0, 1000);
+
+  // test building the index
+  {
+    ccursor_file_t file;
+    ccursor_ret_t ret = ccursor_file_open(&file, TEST_PATH, 16);
+    assert(ret == E_CCURSOR_OK);
+    assert(file.lines == 1000);
+    assert(file.interval == 16);
+    assert(file.sample_count == 63);
+
+    for (uint64_t number = 0; number < 1000; number += 7) {
+      assert_line(&file, number);
+    }
+    assert_line(&file, 999);
+
+    // a range is cut at the file end
+    ccursor_handle_t lines;
+    ret = ccursor_file_lines(&file, 998, 10, &lines);
+    assert(ret == E_CCURSOR_OK);
+    size_t count = 0;
+    ret = ccursor_count_lines(&lines, &count);
+    assert(count == 2);
+
+    ret = ccursor_file_lines(&file, 1000, 1, &lines);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ccursor_file_close(&file);
+  }
+
+  // test the fresh sidecar is reused, including its interval
+  {
+    struct stat st;
+    assert(stat(TEST_SIDECAR, &st) == 0);
+
+    ccursor_file_t file;
+    ccursor_ret_t ret = ccursor_file_open(&file, TEST_PATH, 0);
+    assert(ret == E_CCURSOR_OK);
+    assert(file.interval == 16);
+    assert(file.lines == 1000);
+    assert_line(&file, 500);
+    ccursor_file_close(&file);
+  }
+
+  // test a stale sidecar is rebuilt
+  {
+    write_lines("a", 1000, 24);
+
+    ccursor_file_t file;
+    ccursor_ret_t ret = ccursor_file_open(&file, TEST_PATH, 0);
+    assert(ret == E_CCURSOR_OK);
+    assert(file.interval == CCURSOR_FILE_DEFAULT_INTERVAL);
+    assert(file.lines == 1024);
+    assert_line(&file, 1023);
+    ccursor_file_close(&file);
+  }
+
+  // test a rewritten file with the size and modification time of the
+  // indexed one
+  {
+    remove(TEST_SIDECAR);
+    write_lines("w", 0, 30);
+    ccursor_file_t file;
+    ccursor_ret_t ret = ccursor_file_open(&file, TEST_PATH, 4);
+    assert(ret == E_CCURSOR_OK);
+    size_t size = file.size;
+    char *data = malloc(size);
+    assert(data != NULL);
+
+    // the line breaks before the samples are kept, all others are lost
+    memset(data, 'x', size);
+    for (size_t idx = 1; idx < file.sample_count; idx++) {
+      data[file.samples[idx] - 1] = '\n';
+    }
+    ccursor_file_close(&file);
+    rewrite_file(data, size);
+
+    ret = ccursor_file_open(&file, TEST_PATH, 4);
+    assert(ret == E_CCURSOR_OK);
+    assert(file.lines == 30);
+    ccursor_handle_t lines;
+    ret = ccursor_file_lines(&file, 29, 1, &lines);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ccursor_file_close(&file);
+
+    // a sample not behind a line break rebuilds the index
+    memset(data, 'x', size);
+    data[0] = '\n';
+    rewrite_file(data, size);
+
+    ret = ccursor_file_open(&file, TEST_PATH, 4);
+    assert(ret == E_CCURSOR_OK);
+    assert(file.lines == 2);
+    ret = ccursor_file_lines(&file, 29, 1, &lines);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_file_lines(&file, 1, 1, &lines);
+    assert(ret == E_CCURSOR_OK);
+    assert(lines.buffer_size == size - 1);
+    ccursor_file_close(&file);
+    free(data);
+  }
+
+  // test a missing file
+  {
+    ccursor_file_t file;
+    ccursor_ret_t ret = ccursor_file_open(&file, "missing.log", 0);
+    assert(ret == E_CCURSOR_ERR);
+    assert(file.data == NULL);
+  }
+
+  remove(TEST_PATH);
+  remove(TEST_SIDECAR);
+}
+
+int main() {
+  test_file_lines();
+  return 0;
+}
@@ -0,0 +1,187 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_f64() {
+  ccursor_ret_t ret;
+  // test simple value
+  {
+    ccursor_ret_t ret;
+    char *str = "41.5";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    double num = 0;
+    ret = ccursor_read_f64(&handle, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 41.5);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test negative value with exponent and trailing data
+  {
+    ccursor_ret_t ret;
+    char *str = "-1.25e-3,N";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    double num = 0;
+    ret = ccursor_read_f64(&handle, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == -1.25e-3);
+    ret = ccursor_skip_char(&handle, ',');
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test values requiring correct rounding
+  {
+    double num = 0;
+    ret = ccursor_read_f64(SINGLE_SHOT("0.1"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 0.1);
+    ret = ccursor_read_f64(SINGLE_SHOT("48.1372831"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 48.1372831);
+    ret = ccursor_read_f64(SINGLE_SHOT("1.7976931348623157e308"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 1.7976931348623157e308);
+    ret = ccursor_read_f64(SINGLE_SHOT("4.9406564584124654e-324"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 4.9406564584124654e-324);
+    ret = ccursor_read_f64(SINGLE_SHOT("2.2250738585072011e-308"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 2.2250738585072011e-308);
+    ret = ccursor_read_f64(SINGLE_SHOT("9007199254740993"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 9007199254740992.0);
+  }
+
+  // test value with more significant digits than fit into 64 bits
+  {
+    double num = 0;
+    ccursor_ret_t ret = ccursor_read_f64(
+        SINGLE_SHOT("9007199254740993.0000000000000000000000000001"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 9007199254740994.0);
+
+    ret = ccursor_read_f64(SINGLE_SHOT("0.00000000000000000000000000012345"),
+                           &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 1.2345e-28);
+  }
+
+  // test exponent without digits is not consumed
+  {
+    ccursor_ret_t ret;
+    char *str = "7e";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    double num = 0;
+    ret = ccursor_read_f64(&handle, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 7.0);
+    assert(handle.read_position == str + 1);
+  }
+
+  // test parsing stops at the cursor end
+  {
+    ccursor_ret_t ret;
+    char *str = "12.75";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    handle.buffer_size = 4;
+
+    double num = 0;
+    ret = ccursor_read_f64(&handle, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 12.7);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "1e400";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    double num = 0;
+    ret = ccursor_read_f64(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.buffer == handle.read_position);
+  }
+
+  // test something invalid
+  {
+    ccursor_ret_t ret;
+    char *str = "-.e1";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    double num = 0;
+    ret = ccursor_read_f64(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+  }
+}
+
+void test_f32() {
+  ccursor_ret_t ret;
+  // test simple value
+  {
+    ccursor_ret_t ret;
+    char *str = "+QTEMP: 41.5";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    float num = 0;
+    ret = ccursor_skip_substr(&handle, "+QTEMP:");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_f32(&handle, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 41.5f);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test values requiring correct rounding
+  {
+    float num = 0;
+    ret = ccursor_read_f32(SINGLE_SHOT("0.1"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 0.1f);
+    ret = ccursor_read_f32(SINGLE_SHOT("3.4028234e38"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 3.4028234e38f);
+    ret = ccursor_read_f32(SINGLE_SHOT("1.4e-45"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 1.4e-45f);
+    ret = ccursor_read_f32(SINGLE_SHOT("16777217"), &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 16777216.0f);
+  }
+
+  // test overflow
+  {
+    float num = 0;
+    ccursor_ret_t ret = ccursor_read_f32(SINGLE_SHOT("3.5e38"), &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+  }
+}
+
+int main() {
+  test_f64();
+  test_f32();
+  return 0;
+}
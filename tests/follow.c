@@ -0,0 +1,140 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ccursor_follow.h"
+
+#define TEST_PATH "ccursor_follow_test.log"
+#define TEST_ROTATED TEST_PATH ".1"
+
+static void append(const char *path, const char *text) {
+  FILE *out = fopen(path, "a");
+  assert(out != NULL);
+  fputs(text, out);
+  fclose(out);
+}
+
+static void assert_lines(ccursor_follow_t *follow, int timeout,
+                         const char *expected) {
+  ccursor_handle_t lines;
+  ccursor_ret_t ret = ccursor_follow_next(follow, timeout, &lines);
+  assert(ret == E_CCURSOR_OK);
+  assert(lines.buffer_size == strlen(expected));
+  assert(memcmp(lines.buffer, expected, lines.buffer_size) == 0);
+}
+
+static void assert_no_lines(ccursor_follow_t *follow) {
+  ccursor_handle_t lines;
+  ccursor_ret_t ret = ccursor_follow_next(follow, 0, &lines);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+}
+
+void test_follow_append() {
+  remove(TEST_PATH);
+  append(TEST_PATH, "first\nsecond\nthi");
+
+  ccursor_follow_t follow;
+  ccursor_ret_t ret = ccursor_follow_open(&follow, TEST_PATH, false);
+  assert(ret == E_CCURSOR_OK);
+
+  // test only complete lines are returned
+  assert_lines(&follow, 0, "first\nsecond\n");
+  assert_no_lines(&follow);
+
+  append(TEST_PATH, "rd\nfou");
+  assert_lines(&follow, 0, "third\n");
+  append(TEST_PATH, "rth\n");
+  assert_lines(&follow, 0, "fourth\n");
+
+  // test waiting for a line appended by another process
+  pid_t writer = fork();
+  assert(writer >= 0);
+  if (writer == 0) {
+    usleep(50 * 1000);
+    append(TEST_PATH, "fifth\n");
+    _exit(0);
+  }
+  assert_lines(&follow, 5000, "fifth\n");
+  waitpid(writer, NULL, 0);
+
+  // test the file is read again after a truncation
+  FILE *out = fopen(TEST_PATH, "w");
+  assert(out != NULL);
+  fclose(out);
+  assert_no_lines(&follow);
+  append(TEST_PATH, "restart\n");
+  assert_lines(&follow, 0, "restart\n");
+
+  ccursor_follow_close(&follow);
+  remove(TEST_PATH);
+}
+
+void test_follow_from_end() {
+  remove(TEST_PATH);
+  append(TEST_PATH, "old\nincomplete");
+
+  ccursor_follow_t follow;
+  ccursor_ret_t ret = ccursor_follow_open(&follow, TEST_PATH, true);
+  assert(ret == E_CCURSOR_OK);
+  assert_no_lines(&follow);
+
+  // test the incomplete line at the start is skipped
+  append(TEST_PATH, " line\nnew\n");
+  assert_lines(&follow, 0, "new\n");
+
+  ccursor_follow_close(&follow);
+  remove(TEST_PATH);
+}
+
+void test_follow_rotation() {
+  remove(TEST_PATH);
+  remove(TEST_ROTATED);
+  append(TEST_PATH, "before\n");
+
+  ccursor_follow_t follow;
+  ccursor_ret_t ret = ccursor_follow_open(&follow, TEST_PATH, false);
+  assert(ret == E_CCURSOR_OK);
+  assert_lines(&follow, 0, "before\n");
+
+  // test the rotated file is read up to its end before the new one
+  int result = rename(TEST_PATH, TEST_ROTATED);
+  assert(result == 0);
+  append(TEST_ROTATED, "late\ntail");
+  assert_lines(&follow, 0, "late\n");
+  assert_no_lines(&follow);
+
+  append(TEST_PATH, "after\n");
+  assert_lines(&follow, 0, "tail");
+  assert_lines(&follow, 0, "after\n");
+
+  // test the rotated file is not read anymore
+  append(TEST_ROTATED, "ignored\n");
+  append(TEST_PATH, "last\n");
+  assert_lines(&follow, 0, "last\n");
+
+  ccursor_follow_close(&follow);
+  remove(TEST_PATH);
+  remove(TEST_ROTATED);
+}
+
+void test_follow_invalid() {
+  ccursor_follow_t follow;
+  ccursor_ret_t ret = ccursor_follow_open(&follow, "missing.log", false);
+  assert(ret == E_CCURSOR_ERR);
+  ret = ccursor_follow_open(&follow, NULL, false);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_follow_next(NULL, 0, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+int main() {
+  test_follow_append();
+  test_follow_from_end();
+  test_follow_rotation();
+  test_follow_invalid();
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define CCURSOR_HEADER_ONLY
+#include "ccursor.h"
+
+void test_inline_primitives() {
+  // test the inlined primitives together with library functions
+  {
+    ccursor_ret_t ret;
+    char *str = "A,12;";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    assert(ccursor_available(&handle) == 5);
+
+    char c = '0';
+    ret = ccursor_read_char(&handle, &c);
+    assert(ret == E_CCURSOR_OK);
+    assert(c == 'A');
+    ret = ccursor_skip_char(&handle, ';');
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_skip_char(&handle, ',');
+    assert(ret == E_CCURSOR_OK);
+
+    uint32_t num = 0;
+    ret = ccursor_read_u32(&handle, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 12);
+
+    uint8_t byte = 0;
+    ret = ccursor_read_byte(&handle, &byte);
+    assert(ret == E_CCURSOR_OK);
+    assert(byte == ';');
+    assert(ccursor_available(&handle) == 0);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test the checks at the end of the stream
+  {
+    ccursor_ret_t ret;
+    char *str = "A";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    handle.read_position++;
+
+    char c = '0';
+    ret = ccursor_read_char(&handle, &c);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    assert(c == '0');
+    ret = ccursor_skip_char(&handle, 'A');
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_is_empty(NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    assert(ccursor_available(NULL) == 0);
+  }
+}
+
+int main() {
+  test_inline_primitives();
+  return 0;
+}
@@ -0,0 +1,258 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ccursor_iovec.h"
+
+#define TEST_RESPONSE "+CSQ: 21,-99\r\n+CGPS: 48.2082,16.3738\r\nOK\r\n"
+
+static ccursor_ret_t read_u32(ccursor_handle_t *handle, void *value) {
+  return ccursor_read_u32(handle, value);
+}
+
+static void parse_response(ccursor_iovec_t *cursor) {
+  ccursor_ret_t ret;
+  uint32_t rssi = 0;
+  int32_t ber = 0;
+  double latitude = 0;
+  double longitude = 0;
+
+  ret = ccursor_iovec_skip_substr(cursor, "+CSQ:");
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_read_u32(cursor, &rssi);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_skip_char(cursor, ',');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_read_i32(cursor, &ber);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_skip_until_char(cursor, '\n');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_skip_substr(cursor, "+CGPS: ");
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_read_f64(cursor, &latitude);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_skip_char(cursor, ',');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_read_f64(cursor, &longitude);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_iovec_skip_substr(cursor, "\r\nOK\r");
+  assert(ret == E_CCURSOR_OK);
+
+  char c = 0;
+  ret = ccursor_iovec_read_char(cursor, &c);
+  assert(ret == E_CCURSOR_OK);
+  assert(c == '\n');
+  assert(ccursor_iovec_available(cursor) == 0);
+  ret = ccursor_iovec_read_char(cursor, &c);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  assert(rssi == 21);
+  assert(ber == -99);
+  assert(latitude == 48.2082);
+  assert(longitude == 16.3738);
+}
+
+void test_iovec_segments() {
+  ccursor_ret_t ret;
+  char response[] = TEST_RESPONSE;
+  const size_t size = strlen(response);
+
+  // test a single segment
+  {
+    struct iovec segments[] = {{response, size}};
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, segments, 1);
+    assert(ret == E_CCURSOR_OK);
+    assert(ccursor_iovec_available(&cursor) == size);
+    parse_response(&cursor);
+  }
+
+  // test every split into three segments, with an empty one in between
+  for (size_t first = 0; first <= size; first++) {
+    for (size_t second = first; second <= size; second++) {
+      struct iovec segments[] = {
+          {response, first},
+          {NULL, 0},
+          {response + first, second - first},
+          {response + second, size - second},
+      };
+      ccursor_iovec_t cursor;
+      ret = ccursor_iovec_init(&cursor, segments, 4);
+      assert(ret == E_CCURSOR_OK);
+      assert(ccursor_iovec_available(&cursor) == size);
+      parse_response(&cursor);
+    }
+  }
+
+  // test every segment holds a single character
+  {
+    struct iovec segments[sizeof(TEST_RESPONSE)];
+    for (size_t idx = 0; idx < size; idx++) {
+      segments[idx].iov_base = response + idx;
+      segments[idx].iov_len = 1;
+    }
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, segments, size);
+    assert(ret == E_CCURSOR_OK);
+    parse_response(&cursor);
+  }
+}
+
+void test_iovec_exponents() {
+  ccursor_ret_t ret;
+  struct {
+    char first[8];
+    char second[8];
+    double value;
+    size_t position;
+  } splits[] = {
+      {"1e", "5", 1e5, 3},          // within the exponent
+      {"2.5E-", "3", 2.5e-3, 6},    // behind the sign of the exponent
+      {"2.5E", "-3,", 2.5e-3, 6},   // before the sign of the exponent
+      {"-", "7.25", -7.25, 5},      // behind the sign of the number
+      {"1.5,", "2", 1.5, 3},        // behind the number
+  };
+
+  // test tokens which start far before the end of the first segment
+  {
+    char first[96];
+    memset(first, ' ', sizeof(first));
+    memcpy(first + 90, "1e", 2);
+    char second[] = "5,";
+    struct iovec segments[] = {{first, 92}, {second, 2}};
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, segments, 2);
+    assert(ret == E_CCURSOR_OK);
+
+    double value = 0;
+    ret = ccursor_iovec_read_f64(&cursor, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 1e5);
+    size_t position = ccursor_iovec_position(&cursor);
+    assert(position == 93);
+
+    memcpy(first + 90, "12", 2);
+    char digits[] = "34,";
+    struct iovec numbers[] = {{first, 92}, {digits, 3}};
+    ret = ccursor_iovec_init(&cursor, numbers, 2);
+    assert(ret == E_CCURSOR_OK);
+
+    uint32_t number = 0;
+    ret = ccursor_iovec_read_u32(&cursor, &number);
+    assert(ret == E_CCURSOR_OK);
+    assert(number == 1234);
+    position = ccursor_iovec_position(&cursor);
+    assert(position == 94);
+  }
+
+  // test floats split shortly before the end of the first segment
+  for (size_t idx = 0; idx < sizeof(splits) / sizeof(splits[0]); idx++) {
+    struct iovec segments[] = {
+        {splits[idx].first, strlen(splits[idx].first)},
+        {splits[idx].second, strlen(splits[idx].second)},
+    };
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, segments, 2);
+    assert(ret == E_CCURSOR_OK);
+
+    double value = 0;
+    ret = ccursor_iovec_read_f64(&cursor, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == splits[idx].value);
+    size_t position = ccursor_iovec_position(&cursor);
+    assert(position == splits[idx].position);
+  }
+}
+
+void test_iovec_failures() {
+  ccursor_ret_t ret;
+  char first[] = "12";
+  char second[] = "34x";
+  struct iovec segments[] = {{first, 2}, {second, 3}};
+
+  // test failures leave the cursor unchanged
+  {
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, segments, 2);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_iovec_skip_substr(&cursor, "1234y");
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_iovec_skip_until_char(&cursor, 'z');
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_iovec_skip_char(&cursor, '3');
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(ccursor_iovec_available(&cursor) == 5);
+
+    uint32_t value = 0;
+    ret = ccursor_iovec_read_u32(&cursor, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 1234);
+    ret = ccursor_iovec_read_u32(&cursor, &value);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(ccursor_iovec_available(&cursor) == 1);
+  }
+
+  // test a straddling token longer than the carry buffer
+  {
+    char digits[2 * CCURSOR_IOVEC_CARRY + 8];
+    memset(digits, '0', sizeof(digits));
+    struct iovec long_segments[] = {{digits, 10},
+                                    {digits + 10, sizeof(digits) - 10}};
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, long_segments, 2);
+    assert(ret == E_CCURSOR_OK);
+
+    uint32_t value = 7;
+    ret = ccursor_iovec_read_u32(&cursor, &value);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(value == 7);
+    assert(ccursor_iovec_available(&cursor) == sizeof(digits));
+  }
+
+  // test a token ending shortly before the boundary, too long for the carry
+  {
+    char spaces[2 * CCURSOR_IOVEC_CARRY + 2];
+    memset(spaces, ' ', sizeof(spaces));
+    memcpy(spaces + sizeof(spaces) - 2, "12", 2);
+    char rest[] = "34,";
+    struct iovec long_segments[] = {{spaces, sizeof(spaces)}, {rest, 3}};
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, long_segments, 2);
+    assert(ret == E_CCURSOR_OK);
+
+    uint32_t value = 7;
+    ret = ccursor_iovec_read_u32(&cursor, &value);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(value == 7);
+    size_t position = ccursor_iovec_position(&cursor);
+    assert(position == 0);
+  }
+
+  // test invalid parameters
+  {
+    ccursor_iovec_t cursor;
+    ret = ccursor_iovec_init(&cursor, NULL, 1);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_iovec_init(&cursor, segments, 0);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_iovec_init(&cursor, segments, 2);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_iovec_read(&cursor, NULL, NULL, 0);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    uint32_t value = 0;
+    ret = ccursor_iovec_read(&cursor, read_u32, &value,
+                             CCURSOR_IOVEC_VALUE + 1);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_iovec_read_u32(&cursor, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
+}
+
+int main() {
+  test_iovec_segments();
+  test_iovec_exponents();
+  test_iovec_failures();
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+#define TEST_KEYWORDS CCURSOR_KEYWORD_MAX
+
+static const ccursor_keyword_t states[] = {
+    {"READY", 0},      {"SIM PIN", 1},  {"SIM PUK", 2},
+    {"PH-SIM PIN", 3}, {"SIM PIN2", 4}, {"SIM PUK2", 5},
+};
+
+void test_keyword_read() {
+  ccursor_ret_t ret;
+  ccursor_keyword_set_t set;
+  ret = ccursor_keyword_init(&set, states, 6, ',');
+  assert(ret == E_CCURSOR_OK);
+
+  // test keywords followed by the separator and at the end of the stream
+  {
+    char *str = "SIM PIN2,READY,SIM PIN";
+    ccursor_handle_t handle;
+    uint32_t value = 99;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_keyword(&handle, &set, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 4 && handle.read_position == str + 9);
+    ret = ccursor_read_keyword(&handle, &set, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 0 && handle.read_position == str + 15);
+    ret = ccursor_read_keyword(&handle, &set, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 1 && handle.read_position == str + strlen(str));
+  }
+
+  // test unknown, empty, truncated and overlong tokens leave the position
+  {
+    const char *tokens[] = {"SIM PIN3,", ",READY", "SIM", "READY READY,",
+                            "SIM PIN SIM PIN SIM PIN"};
+    for (size_t idx = 0; idx < 5; idx++) {
+      ccursor_handle_t handle;
+      uint32_t value = 99;
+      char *str = (char *)tokens[idx];
+      ret = ccursor_init(&handle, str, strlen(str));
+      assert(ret == E_CCURSOR_OK);
+      ret = ccursor_read_keyword(&handle, &set, &value);
+      assert(ret == E_CCURSOR_ERR_PARSE);
+      assert(handle.read_position == str && value == 99);
+    }
+  }
+
+  // test the token ends at the end of a line view
+  {
+    char *str = "READY\nSIM PIN";
+    ccursor_handle_t handle;
+    ccursor_handle_t line;
+    uint32_t value = 99;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_keyword(&line, &set, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 0);
+  }
+}
+
+void test_keyword_large() {
+  ccursor_ret_t ret;
+  // test a full table of similar keywords maps every one
+  static char keywords[TEST_KEYWORDS][16];
+  static ccursor_keyword_t table[TEST_KEYWORDS];
+  for (size_t idx = 0; idx < TEST_KEYWORDS; idx++) {
+    snprintf(keywords[idx], sizeof(keywords[idx]), "MODE%zu", idx);
+    table[idx].keyword = keywords[idx];
+    table[idx].value = (uint32_t)(1000 + idx);
+  }
+
+  ccursor_keyword_set_t set;
+  ret = ccursor_keyword_init(&set, table, TEST_KEYWORDS, ' ');
+  assert(ret == E_CCURSOR_OK);
+  for (size_t idx = 0; idx < TEST_KEYWORDS; idx++) {
+    ccursor_handle_t handle;
+    uint32_t value = 0;
+    ret = ccursor_init(&handle, keywords[idx], strlen(keywords[idx]));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_keyword(&handle, &set, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 1000 + idx);
+  }
+
+  // test keywords outside the table are rejected
+  for (size_t idx = TEST_KEYWORDS; idx < 4 * TEST_KEYWORDS; idx++) {
+    char str[16];
+    ccursor_handle_t handle;
+    uint32_t value = 0;
+    snprintf(str, sizeof(str), "MODE%zu", idx);
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_keyword(&handle, &set, &value);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+  }
+}
+
+void test_keyword_invalid() {
+  ccursor_ret_t ret;
+  ccursor_keyword_set_t set;
+  const ccursor_keyword_t duplicated[] = {{"OK", 0}, {"OK", 1}};
+  const ccursor_keyword_t empty[] = {{"OK", 0}, {"", 1}};
+  const ccursor_keyword_t separated[] = {{"SIM,PIN", 0}};
+  ret = ccursor_keyword_init(&set, duplicated, 2, ',');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_keyword_init(&set, empty, 2, ',');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_keyword_init(&set, separated, 1, ',');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_keyword_init(&set, states, TEST_KEYWORDS + 1, ',');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_keyword_init(NULL, states, 6, ',');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  // test an empty set never matches
+  char *str = "READY";
+  ccursor_handle_t handle;
+  uint32_t value = 0;
+  ret = ccursor_keyword_init(&set, NULL, 0, ',');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_read_keyword(&handle, &set, &value);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+  ret = ccursor_read_keyword(&handle, NULL, &value);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+int main() {
+  test_keyword_read();
+  test_keyword_large();
+  test_keyword_invalid();
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_next_line() {
+  // test iterating LF and CRLF terminated lines
+  {
+    ccursor_ret_t ret;
+    char *str = "OK\r\n\n+CSQ: 23,99\nlast";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ccursor_handle_t line;
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    assert(line.buffer == str && line.buffer_size == 2);
+
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    assert(line.buffer_size == 0);
+
+    // the line works with every reader
+    uint8_t rssi = 0;
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_substr(&line, "+CSQ:");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_u8(&line, &rssi);
+    assert(ret == E_CCURSOR_OK);
+    assert(rssi == 23);
+
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    assert(line.buffer_size == 4);
+    assert(strncmp(line.buffer, "last", 4) == 0);
+
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test a line longer than any block
+  {
+    char str[300];
+    memset(str, 'x', sizeof(str) - 1);
+    str[250] = '\n';
+    str[sizeof(str) - 1] = '\0';
+
+    ccursor_handle_t handle;
+    ccursor_ret_t ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    ccursor_handle_t line;
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    assert(line.buffer_size == 250);
+    assert(handle.read_position == str + 251);
+  }
+}
+
+void test_count_lines() {
+  ccursor_ret_t ret;
+  // test terminated and unterminated last lines
+  {
+    size_t count = 0;
+    ret = ccursor_count_lines(SINGLE_SHOT("a\nb\n"), &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 2);
+    ret = ccursor_count_lines(SINGLE_SHOT("a\nb"), &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 2);
+    ret = ccursor_count_lines(SINGLE_SHOT("\n"), &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 1);
+  }
+
+  // test counting matches the iterator on a large buffer
+  {
+    static char str[20000];
+    for (size_t idx = 0; idx < sizeof(str) - 1; idx++) {
+      str[idx] = (idx * 7 % 13 == 0) ? '\n' : 'a';
+    }
+    str[sizeof(str) - 1] = '\0';
+
+    ccursor_handle_t handle;
+    ccursor_ret_t ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    size_t count = 0;
+    ret = ccursor_count_lines(&handle, &count);
+    assert(ret == E_CCURSOR_OK);
+
+    size_t lines = 0;
+    ccursor_handle_t line;
+    while (ccursor_next_line(&handle, &line) == E_CCURSOR_OK) {
+      lines++;
+    }
+    assert(lines == count);
+  }
+}
+
+int main() {
+  test_next_line();
+  test_count_lines();
+  return 0;
+}
@@ -0,0 +1,160 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_u32_list() {
+  // test short list
+  {
+    ccursor_ret_t ret;
+    char *str = "+CIND: 1,0,3,0,1,0,0";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    uint32_t values[10];
+    size_t count = 0;
+    ret = ccursor_skip_substr(&handle, "+CIND: ");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_u32_list(&handle, ',', values, 10, &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 7);
+    assert(values[0] == 1 && values[1] == 0 && values[2] == 3);
+    assert(values[6] == 0);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test long list with mixed element lengths
+  {
+    ccursor_ret_t ret;
+    char str[2048];
+    size_t size = 0;
+    for (uint32_t idx = 0; idx < 200; idx++) {
+      size += sprintf(str + size, "%s%u", idx ? ";" : "", idx * idx * 1013);
+    }
+    size += sprintf(str + size, ";;");
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, size);
+
+    // parse
+    uint32_t values[256];
+    size_t count = 0;
+    ret = ccursor_read_u32_list(&handle, ';', values, 256, &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 200);
+    for (uint32_t idx = 0; idx < 200; idx++) {
+      assert(values[idx] == idx * idx * 1013);
+    }
+
+    // the separator in front of the invalid element is left over
+    ret = ccursor_skip_substr(&handle, ";;");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test list exceeding the capacity
+  {
+    ccursor_ret_t ret;
+    char *str = "10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t values[4];
+    size_t count = 0;
+    ret = ccursor_read_u32_list(&handle, ',', values, 4, &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 4);
+    assert(values[3] == 13);
+    ret = ccursor_skip_char(&handle, ',');
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test elements with spaces and an overflowing element
+  {
+    ccursor_ret_t ret;
+    char *str = "1, 2, 4294967296";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t values[4];
+    size_t count = 0;
+    ret = ccursor_read_u32_list(&handle, ',', values, 4, &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 2);
+    assert(values[1] == 2);
+    assert(handle.read_position == str + 4);
+  }
+
+  // test invalid first element
+  {
+    ccursor_ret_t ret;
+    char *str = "x,1";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t values[4];
+    size_t count = 1;
+    ret = ccursor_read_u32_list(&handle, ',', values, 4, &count);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(count == 0);
+    assert(handle.buffer == handle.read_position);
+  }
+}
+
+void test_i32_list() {
+  // test signed list
+  {
+    ccursor_ret_t ret;
+    char *str = "-1,2,-2147483648,2147483647,0,12345678,-5,6,7,8,9,10,11\r\n";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    int32_t values[16];
+    size_t count = 0;
+    ret = ccursor_read_i32_list(&handle, ',', values, 16, &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 13);
+    assert(values[0] == -1);
+    assert(values[2] == INT32_MIN);
+    assert(values[3] == INT32_MAX);
+    assert(values[5] == 12345678);
+    assert(values[6] == -5);
+    assert(values[12] == 11);
+    ret = ccursor_skip_substr(&handle, "\r\n");
+    assert(ret == E_CCURSOR_OK);
+  }
+}
+
+void test_hex_list() {
+  // test hex list
+  {
+    ccursor_ret_t ret;
+    char *str = "0x1A:ff:0:DEADBEEF:g";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t values[8];
+    size_t count = 0;
+    ret = ccursor_read_hex_list(&handle, ':', values, 8, &count);
+    assert(ret == E_CCURSOR_OK);
+    assert(count == 4);
+    assert(values[0] == 0x1A);
+    assert(values[1] == 0xFF);
+    assert(values[2] == 0);
+    assert(values[3] == 0xDEADBEEF);
+    ret = ccursor_skip_substr(&handle, ":g");
+    assert(ret == E_CCURSOR_OK);
+  }
+}
+
+int main() {
+  test_u32_list();
+  test_i32_list();
+  test_hex_list();
+  return 0;
+}
@@ -0,0 +1,317 @@
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "ccursor_mux.h"
+
+#define TEST_MODEMS 32
+#define TEST_URCS 50
+#define TEST_FRAMES 8
+
+/**
+ * @brief Pseudo-terminal standing in for a modem
+ */
+typedef struct {
+  int modem; // master side, written by the test as the modem
+  int tty;   // slave side, watched by the multiplexer
+} test_pty_t;
+
+/**
+ * @brief Frames received from a modem
+ */
+typedef struct {
+  size_t count;
+  ccursor_frame_type_t types[TEST_FRAMES];
+  char lines[TEST_FRAMES][64];
+  uint32_t next_urc;
+  bool ordered;
+} test_modem_t;
+
+static pthread_mutex_t received_lock = PTHREAD_MUTEX_INITIALIZER;
+static size_t received = 0;
+
+static void open_pty(test_pty_t *pty) {
+  pty->modem = posix_openpt(O_RDWR | O_NOCTTY);
+  assert(pty->modem >= 0);
+  int result = grantpt(pty->modem);
+  assert(result == 0);
+  result = unlockpt(pty->modem);
+  assert(result == 0);
+  pty->tty = open(ptsname(pty->modem), O_RDWR | O_NOCTTY);
+  assert(pty->tty >= 0);
+
+  // pass all bytes unchanged, like a tty in raw mode
+  struct termios attributes;
+  result = tcgetattr(pty->tty, &attributes);
+  assert(result == 0);
+  cfmakeraw(&attributes);
+  result = tcsetattr(pty->tty, TCSANOW, &attributes);
+  assert(result == 0);
+}
+
+static void write_modem(const test_pty_t *pty, const char *text) {
+  size_t length = strlen(text);
+  ssize_t written = write(pty->modem, text, length);
+  assert(written == (ssize_t)length);
+}
+
+static void record_frame(const ccursor_frame_t *frame) {
+  test_modem_t *modem = frame->context;
+  assert(modem->count < TEST_FRAMES);
+  assert(frame->lines.buffer_size < sizeof(modem->lines[0]));
+  modem->types[modem->count] = frame->type;
+  memcpy(modem->lines[modem->count], frame->lines.buffer,
+         frame->lines.buffer_size);
+  modem->lines[modem->count][frame->lines.buffer_size] = '\0';
+  modem->count++;
+}
+
+static void count_urc(const ccursor_frame_t *frame) {
+  ccursor_ret_t ret;
+  test_modem_t *modem = frame->context;
+  if (frame->type == E_CCURSOR_FRAME_URC) {
+    // URCs of a modem arrive in order, even with several workers
+    ccursor_handle_t lines = frame->lines;
+    uint32_t number = 0;
+    ret = ccursor_skip_substr(&lines, "+N: ");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_u32(&lines, &number);
+    assert(ret == E_CCURSOR_OK);
+    modem->ordered = modem->ordered && (number == modem->next_urc);
+    modem->next_urc++;
+  }
+
+  pthread_mutex_lock(&received_lock);
+  received++;
+  pthread_mutex_unlock(&received_lock);
+}
+
+static void poll_frames(ccursor_mux_t *mux, size_t expected) {
+  ccursor_ret_t ret;
+  size_t total = 0;
+  while (total < expected) {
+    size_t frames = 0;
+    ret = ccursor_mux_poll(mux, 1000, &frames);
+    assert(ret == E_CCURSOR_OK);
+    assert(frames > 0);
+    total += frames;
+  }
+  assert(total == expected);
+}
+
+static void poll_count(ccursor_mux_t *mux, const test_modem_t *modem,
+                       size_t count) {
+  // long writes arrive in several pieces, not each of them ends a frame
+  ccursor_ret_t ret;
+  size_t idle = 0;
+  while (modem->count < count) {
+    size_t frames = 0;
+    ret = ccursor_mux_poll(mux, 1000, &frames);
+    assert(ret == E_CCURSOR_OK);
+    idle = (frames == 0) ? idle + 1 : 0;
+    assert(idle < 10);
+  }
+  assert(modem->count == count);
+}
+
+void test_mux_framing() {
+  ccursor_ret_t ret;
+  const char *urcs[] = {"+CREG:", NULL};
+  ccursor_mux_config_t config = {
+      .callback = record_frame,
+      .workers = 0,
+      .urcs = urcs,
+  };
+  ccursor_mux_t *mux = NULL;
+  ret = ccursor_mux_create(&mux, &config);
+  assert(ret == E_CCURSOR_OK);
+
+  test_pty_t pty;
+  open_pty(&pty);
+  test_modem_t modem = {0};
+  ret = ccursor_mux_add(mux, pty.tty, &modem);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_mux_add(mux, pty.tty, &modem);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  // test lines without a pending command are URCs
+  write_modem(&pty, "\r\n+CREG: 1\r\n\r\nRING\r\n");
+  poll_frames(mux, 2);
+  assert(modem.types[0] == E_CCURSOR_FRAME_URC);
+  assert(strcmp(modem.lines[0], "+CREG: 1\r\n") == 0);
+  assert(strcmp(modem.lines[1], "RING\r\n") == 0);
+
+  // test a response split into pieces with an URC in between
+  ret = ccursor_mux_send(mux, pty.tty, "AT+CSQ\r");
+  assert(ret == E_CCURSOR_OK);
+  char command[16] = {0};
+  ssize_t size = read(pty.modem, command, sizeof(command));
+  assert(size == 7);
+  assert(strcmp(command, "AT+CSQ\r") == 0);
+
+  write_modem(&pty, "\r\n+CSQ: 2");
+  write_modem(&pty, "1,99\r\n\r\n+CREG: 2\r\n");
+  poll_frames(mux, 1);
+  assert(strcmp(modem.lines[2], "+CREG: 2\r\n") == 0);
+  write_modem(&pty, "\r\nOK\r\n");
+  poll_frames(mux, 1);
+  assert(modem.types[3] == E_CCURSOR_FRAME_OK);
+  assert(strcmp(modem.lines[3], "+CSQ: 21,99\r\nOK\r\n") == 0);
+
+  // test an error code finishes a response
+  ret = ccursor_mux_send(mux, pty.tty, "AT+CPIN?\r");
+  assert(ret == E_CCURSOR_OK);
+  write_modem(&pty, "\r\n+CME ERROR: 10\r\n");
+  poll_frames(mux, 1);
+  assert(modem.types[4] == E_CCURSOR_FRAME_ERROR);
+  assert(strcmp(modem.lines[4], "+CME ERROR: 10\r\n") == 0);
+
+  // test a closed modem is reported and removed
+  close(pty.modem);
+  poll_frames(mux, 1);
+  assert(modem.types[5] == E_CCURSOR_FRAME_HANGUP);
+  assert(modem.lines[5][0] == '\0');
+  ret = ccursor_mux_remove(mux, pty.tty);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_mux_send(mux, pty.tty, "AT\r");
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  close(pty.tty);
+  ccursor_mux_destroy(mux);
+}
+
+void test_mux_overlong() {
+  ccursor_ret_t ret;
+  ccursor_mux_config_t config = {
+      .callback = record_frame,
+      .workers = 0,
+      .urcs = NULL,
+  };
+  ccursor_mux_t *mux = NULL;
+  ret = ccursor_mux_create(&mux, &config);
+  assert(ret == E_CCURSOR_OK);
+
+  test_pty_t pty;
+  open_pty(&pty);
+  test_modem_t modem = {0};
+  ret = ccursor_mux_add(mux, pty.tty, &modem);
+  assert(ret == E_CCURSOR_OK);
+
+  // the end of the overlong line looks like a final result code
+  static char line[CCURSOR_MUX_BUFFER_SIZE + 8];
+  memset(line, 'x', CCURSOR_MUX_BUFFER_SIZE);
+  strcpy(line + CCURSOR_MUX_BUFFER_SIZE, "OK\r\n");
+
+  // test an overlong URC is dropped up to its line break
+  write_modem(&pty, line);
+  write_modem(&pty, "RING\r\n");
+  poll_count(mux, &modem, 1);
+  assert(modem.types[0] == E_CCURSOR_FRAME_URC);
+  assert(strcmp(modem.lines[0], "RING\r\n") == 0);
+
+  // test a response with an overlong line finishes as an error
+  ret = ccursor_mux_send(mux, pty.tty, "AT+COPS=?\r");
+  assert(ret == E_CCURSOR_OK);
+  write_modem(&pty, "\r\n");
+  write_modem(&pty, line);
+  write_modem(&pty, "\r\nOK\r\n");
+  poll_count(mux, &modem, 2);
+  assert(modem.types[1] == E_CCURSOR_FRAME_ERROR);
+  assert(strcmp(modem.lines[1], "OK\r\n") == 0);
+
+  // test the next response is complete again
+  ret = ccursor_mux_send(mux, pty.tty, "AT\r");
+  assert(ret == E_CCURSOR_OK);
+  write_modem(&pty, "\r\nOK\r\n");
+  poll_count(mux, &modem, 3);
+  assert(modem.types[2] == E_CCURSOR_FRAME_OK);
+  assert(modem.count == 3);
+
+  ret = ccursor_mux_remove(mux, pty.tty);
+  assert(ret == E_CCURSOR_OK);
+  close(pty.modem);
+  close(pty.tty);
+  ccursor_mux_destroy(mux);
+}
+
+void test_mux_workers() {
+  ccursor_ret_t ret;
+  ccursor_mux_config_t config = {
+      .callback = count_urc,
+      .workers = 3,
+      .urcs = NULL,
+  };
+  ccursor_mux_t *mux = NULL;
+  ret = ccursor_mux_create(&mux, &config);
+  assert(ret == E_CCURSOR_OK);
+
+  test_pty_t ptys[TEST_MODEMS];
+  test_modem_t modems[TEST_MODEMS];
+  memset(modems, 0, sizeof(modems));
+  for (size_t idx = 0; idx < TEST_MODEMS; idx++) {
+    open_pty(&ptys[idx]);
+    modems[idx].ordered = true;
+    ret = ccursor_mux_add(mux, ptys[idx].tty, &modems[idx]);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test the URCs of all modems are dispatched on the workers
+  char line[32];
+  for (uint32_t number = 0; number < TEST_URCS; number++) {
+    for (size_t idx = 0; idx < TEST_MODEMS; idx++) {
+      snprintf(line, sizeof(line), "+N: %u\r\n", number);
+      write_modem(&ptys[idx], line);
+    }
+  }
+  poll_frames(mux, TEST_MODEMS * TEST_URCS);
+
+  // the workers finish their queues before they are stopped
+  for (size_t idx = 0; idx < TEST_MODEMS; idx++) {
+    ret = ccursor_mux_remove(mux, ptys[idx].tty);
+    assert(ret == E_CCURSOR_OK);
+  }
+  ccursor_mux_destroy(mux);
+  assert(received == TEST_MODEMS * TEST_URCS);
+
+  for (size_t idx = 0; idx < TEST_MODEMS; idx++) {
+    assert(modems[idx].ordered);
+    assert(modems[idx].next_urc == TEST_URCS);
+    close(ptys[idx].modem);
+    close(ptys[idx].tty);
+  }
+}
+
+void test_mux_invalid() {
+  ccursor_ret_t ret;
+  ccursor_mux_t *mux = NULL;
+  ccursor_mux_config_t config = {.callback = NULL};
+  ret = ccursor_mux_create(&mux, &config);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_mux_create(NULL, &config);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  const char *urcs[] = {"+CREG:", "+CREG:", NULL};
+  config.callback = record_frame;
+  config.urcs = urcs;
+  ret = ccursor_mux_create(&mux, &config);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_mux_add(NULL, 0, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_mux_poll(NULL, 0, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+int main() {
+  test_mux_framing();
+  test_mux_overlong();
+  test_mux_workers();
+  test_mux_invalid();
+  return 0;
+}
@@ -91,6 +91,39 @@ void test_u32() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "4294967296";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    uint32_t num = 0;
+    ret = ccursor_read_u32(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+  }
+
+  // test parsing stops at the cursor end
+  {
+    ccursor_ret_t ret;
+    char *str = "1234567890";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    handle.buffer_size = 9;
+
+    // parse
+    uint32_t num = 0;
+    ret = ccursor_read_u32(&handle, &num);
+    assert(ret == E_CCURSOR_OK);
+    assert(num == 123456789);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
 }
 
 void test_u16() {
@@ -181,6 +214,21 @@ void test_u16() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "65536";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    uint16_t num = 0;
+    ret = ccursor_read_u16(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+  }
 }
 
 void test_u8() {
@@ -343,6 +391,21 @@ void test_i32() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "-2147483649";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    int32_t num = 0;
+    ret = ccursor_read_i32(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+  }
 }
 
 void test_i16() {
@@ -487,6 +550,21 @@ void test_i8() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test underflow
+  {
+    ccursor_ret_t ret;
+    char *str = "-129";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    int8_t num = 0;
+    ret = ccursor_read_i8(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+  }
 }
 
 void test_u32_le() {
@@ -744,6 +822,25 @@ void test_u16_be() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "10000";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    uint16_t num = 0;
+    ret = ccursor_read_u16_be(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+    ret = ccursor_read_u16_be(&handle, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_read_u16_be(NULL, &num);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
 }
 
 void test_u8_le() {
@@ -872,6 +969,25 @@ void test_u8_be() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "100";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    uint8_t num = 0;
+    ret = ccursor_read_u8_be(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+    ret = ccursor_read_u8_be(&handle, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_read_u8_be(NULL, &num);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
 }
 
 void test_i32_le() {
@@ -1192,6 +1308,25 @@ void test_i16_be() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "10000";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    int16_t num = 0;
+    ret = ccursor_read_i16_be(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+    ret = ccursor_read_i16_be(&handle, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_read_i16_be(NULL, &num);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
 }
 
 void test_i8_be() {
@@ -1256,6 +1391,25 @@ void test_i8_be() {
     ret = ccursor_is_empty(&handle);
     assert(ret == E_CCURSOR_ERR);
   }
+
+  // test overflow
+  {
+    ccursor_ret_t ret;
+    char *str = "ffffff80";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    // parse
+    int8_t num = 0;
+    ret = ccursor_read_i8_be(&handle, &num);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(num == 0);
+    assert(handle.buffer == handle.read_position);
+    ret = ccursor_read_i8_be(&handle, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_read_i8_be(NULL, &num);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
 }
 
 int main() {
@@ -0,0 +1,151 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+static const char *const urcs[] = {"+CREG:", "+CGREG:", "+CSQ:", "+QIURC:",
+                                   "RING",   "+CGREG",  "NO CARRIER"};
+
+void test_prefix_dispatch() {
+  ccursor_ret_t ret;
+  ccursor_prefix_set_t set;
+  ret = ccursor_prefix_init(&set, urcs, 7);
+  assert(ret == E_CCURSOR_OK);
+
+  // test each prefix is identified and skipped
+  for (size_t idx = 0; idx < 7; idx++) {
+    char line[32];
+    snprintf(line, sizeof(line), "%s 1,2", urcs[idx]);
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, line, strlen(line));
+    assert(ret == E_CCURSOR_OK);
+
+    size_t index = 99;
+    ret = ccursor_skip_prefix(&handle, &set, &index);
+    assert(ret == E_CCURSOR_OK);
+    assert(index == idx);
+    assert(handle.read_position == line + strlen(urcs[idx]));
+  }
+
+  // test the longest prefix wins, also if it is the last character
+  {
+    char *str = "+CGREG";
+    ccursor_handle_t handle;
+    size_t index = 0;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_prefix(&handle, &set, &index);
+    assert(ret == E_CCURSOR_OK);
+    assert(index == 5);
+    assert(handle.read_position == str + 6);
+  }
+
+  // test unknown lines leave the position unchanged
+  {
+    char *str = "+CGATT: 1";
+    ccursor_handle_t handle;
+    size_t index = 99;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_prefix(&handle, &set, &index);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.read_position == str && index == 99);
+  }
+
+  // test the walk stops at the end of a line
+  {
+    char *str = "+CSQ\n+CSQ: 5";
+    ccursor_handle_t handle;
+    ccursor_handle_t line;
+    size_t index = 0;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_prefix(&line, &set, &index);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+  }
+}
+
+void test_prefix_substr() {
+  ccursor_ret_t ret;
+  // test substrings are only compared within a line
+  {
+    char *str = "+CSQ\n: 5\nOK";
+    ccursor_handle_t handle;
+    ccursor_handle_t line;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_next_line(&handle, &line);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_substr(&line, "+CSQ:");
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_skip_until_substr(&line, "OK");
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_skip_until_substr(&line, "SQ");
+    assert(ret == E_CCURSOR_OK);
+    assert(line.read_position == str + 4);
+  }
+
+  // test the search finds a match ending at the end of the buffer
+  {
+    char *str = "aabaab";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_until_substr(&handle, "aab");
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.read_position == str + 3);
+    ret = ccursor_skip_until_substr(&handle, "aab");
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.read_position == str + 6);
+  }
+}
+
+void test_prefix_invalid() {
+  ccursor_ret_t ret;
+  ccursor_prefix_set_t set;
+  const char *const duplicated[] = {"OK", "ERROR", "OK"};
+  const char *const empty[] = {"OK", ""};
+  ret = ccursor_prefix_init(&set, duplicated, 3);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_prefix_init(&set, empty, 2);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_prefix_init(NULL, urcs, 7);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  // test a trie exceeding the nodes
+  static char long_prefixes[CCURSOR_PREFIX_MAX_NODES / 4][10];
+  const char *table[CCURSOR_PREFIX_MAX_NODES / 4];
+  for (size_t idx = 0; idx < CCURSOR_PREFIX_MAX_NODES / 4; idx++) {
+    snprintf(long_prefixes[idx], sizeof(long_prefixes[idx]), "%03zu-abcde",
+             idx);
+    table[idx] = long_prefixes[idx];
+  }
+  ret = ccursor_prefix_init(&set, table, CCURSOR_PREFIX_MAX_NODES / 4);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_prefix_init(&set, table, 8);
+  assert(ret == E_CCURSOR_OK);
+
+  // test an empty set never matches
+  char *str = "OK";
+  ccursor_handle_t handle;
+  size_t index = 0;
+  ret = ccursor_prefix_init(&set, urcs, 0);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_prefix(&handle, &set, &index);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+  ret = ccursor_skip_prefix(&handle, NULL, &index);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+int main() {
+  test_prefix_dispatch();
+  test_prefix_substr();
+  test_prefix_invalid();
+  return 0;
+}
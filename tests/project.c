@@ -0,0 +1,135 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_project_columns() {
+  // test projecting typed columns line by line
+  {
+    ccursor_ret_t ret;
+    char *str = "a,1,x,-2,1.5,0.25,z\r\n"
+                "b,2,y,-3,2.5,1.75,z\n"
+                "c,3\n";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t ids[4] = {0};
+    int32_t deltas[4] = {0};
+    double ratios[4] = {0};
+    int64_t prices[4] = {0};
+    ccursor_column_t columns[] = {
+        {.type = E_CCURSOR_COLUMN_U32, .values = ids},
+        {.type = E_CCURSOR_COLUMN_I32, .values = deltas},
+        {.type = E_CCURSOR_COLUMN_F64, .values = ratios},
+        {.type = E_CCURSOR_COLUMN_DECIMAL, .scale = 2, .values = prices},
+    };
+    ccursor_projection_t projection = {
+        .selected = (1 << 1) | (1 << 3) | (1 << 4) | (1 << 5),
+        .columns = columns,
+        .capacity = 4,
+    };
+
+    ret = ccursor_project_columns(&handle, ',', &projection);
+    assert(ret == E_CCURSOR_OK);
+    assert(projection.rows == 2);
+    assert(ids[0] == 1 && ids[1] == 2);
+    assert(deltas[0] == -2 && deltas[1] == -3);
+    assert(ratios[0] == 1.5 && ratios[1] == 2.5);
+    assert(prices[0] == 25 && prices[1] == 175);
+
+    // the third line has too few columns
+    assert(handle.read_position == strstr(str, "c,3"));
+    ret = ccursor_project_columns(&handle, ',', &projection);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(projection.rows == 0);
+  }
+
+  // test a selected field which is not a value
+  {
+    ccursor_ret_t ret;
+    char *str = "1;2\n3x;4";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t values[2] = {0};
+    ccursor_column_t column = {.type = E_CCURSOR_COLUMN_U32, .values = values};
+    ccursor_projection_t projection = {
+        .selected = 1, .columns = &column, .capacity = 2};
+
+    ret = ccursor_project_columns(&handle, ';', &projection);
+    assert(ret == E_CCURSOR_OK);
+    assert(projection.rows == 1);
+    assert(values[0] == 1);
+    assert(handle.read_position == str + 4);
+
+    projection.selected = 0;
+    ret = ccursor_project_columns(&handle, ';', &projection);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
+
+  // test an empty field does not take the value of the next line
+  {
+    ccursor_ret_t ret;
+    char *str = "\n5";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t values[2] = {0};
+    ccursor_column_t column = {.type = E_CCURSOR_COLUMN_U32, .values = values};
+    ccursor_projection_t projection = {
+        .selected = 1, .columns = &column, .capacity = 2};
+
+    ret = ccursor_project_columns(&handle, ',', &projection);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.read_position == str);
+  }
+
+  // test wide lines crossing the block size of the separator count
+  {
+    char str[4096];
+    size_t length = 0;
+    for (uint32_t row = 0; row < 4; row++) {
+      for (uint32_t column = 0; column < 40; column++) {
+        length += (size_t)snprintf(str + length, sizeof(str) - length, "%s%u",
+                                   column > 0 ? "," : "", row * 100 + column);
+      }
+      str[length++] = '\n';
+    }
+    str[length] = '\0';
+
+    ccursor_handle_t handle;
+    ccursor_ret_t ret = ccursor_init(&handle, str, (uint32_t)length);
+
+    uint32_t third[4] = {0};
+    uint32_t seventh[4] = {0};
+    uint32_t last[4] = {0};
+    ccursor_column_t columns[] = {
+        {.type = E_CCURSOR_COLUMN_U32, .values = third},
+        {.type = E_CCURSOR_COLUMN_U32, .values = seventh},
+        {.type = E_CCURSOR_COLUMN_U32, .values = last},
+    };
+    ccursor_projection_t projection = {
+        .selected = (1ULL << 3) | (1ULL << 7) | (1ULL << 39),
+        .columns = columns,
+        .capacity = 4,
+    };
+
+    ret = ccursor_project_columns(&handle, ',', &projection);
+    assert(ret == E_CCURSOR_OK);
+    assert(projection.rows == 4);
+    for (uint32_t row = 0; row < 4; row++) {
+      assert(third[row] == row * 100 + 3);
+      assert(seventh[row] == row * 100 + 7);
+      assert(last[row] == row * 100 + 39);
+    }
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+}
+
+int main() {
+  test_project_columns();
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_rfind_char() {
+  ccursor_ret_t ret;
+  // test every position of the last character in every buffer length, the
+  // lengths cover the block sizes of all kernels plus their heads
+  {
+    char str[200];
+    for (size_t length = 1; length <= sizeof(str); length++) {
+      for (size_t at = 0; at <= length; at++) {
+        memset(str, 'a', sizeof(str));
+        // characters in front of the cursor and behind the end must not be
+        // found
+        str[0] = '_';
+        if (length < sizeof(str)) {
+          str[length] = '_';
+        }
+        if (at > 0 && at < length) {
+          str[at] = '_';
+          str[at / 2 + 1] = '_';
+        }
+
+        ccursor_handle_t handle = {
+            .buffer = str, .buffer_size = length, .read_position = str + 1};
+        if (length == 1) {
+          ret = ccursor_rfind_char(&handle, '_');
+          assert(ret == E_CCURSOR_ERR_PARAM);
+          continue;
+        }
+        ccursor_ret_t ret = ccursor_rfind_char(&handle, '_');
+        if (at > 0 && at < length) {
+          assert(ret == E_CCURSOR_OK);
+          assert(handle.read_position == str + at + 1);
+        } else {
+          assert(ret == E_CCURSOR_ERR_PARSE);
+          assert(handle.read_position == str + 1);
+        }
+      }
+    }
+  }
+}
+
+void test_rfind_substr() {
+  ccursor_ret_t ret;
+  // test the last occurrence is found, also overlapping ones
+  {
+    char *str = "a,b,,c,,,d";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_rfind_substr(&handle, ",,");
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.read_position == str + 9);
+    ret = ccursor_rfind_substr(&handle, ",,");
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.read_position == str + 9);
+  }
+
+  // test a substring longer than the stream and one behind the end
+  {
+    char *str = "OK\r\nERROR";
+    ccursor_handle_t handle = {
+        .buffer = str, .buffer_size = 4, .read_position = str};
+    ret = ccursor_rfind_substr(&handle, "OK\r\nE");
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_rfind_substr(&handle, "\r\n");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test a long buffer with the substring at its start
+  {
+    char str[150];
+    memset(str, 'x', sizeof(str));
+    memcpy(str, "END", 3);
+    ccursor_handle_t handle = {
+        .buffer = str, .buffer_size = sizeof(str), .read_position = str};
+    ret = ccursor_rfind_substr(&handle, "END");
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.read_position == str + 3);
+  }
+}
+
+void test_rfind_nmea() {
+  ccursor_ret_t ret;
+  // test splitting an NMEA sentence into its payload and checksum
+  char *str = "$GPGLL,4916.45,N,12311.12,W,225444,A*1D";
+  ccursor_handle_t payload;
+  ccursor_handle_t checksum;
+  ret = ccursor_init(&payload, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  checksum = payload;
+
+  uint8_t value = 0;
+  ret = ccursor_rfind_char(&checksum, '*');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_read_u8_be(&checksum, &value);
+  assert(ret == E_CCURSOR_OK);
+  assert(value == 0x1D);
+
+  // test the status is read behind the last separator of the payload
+  char status = 0;
+  ret = ccursor_trim_right_at_char(&payload, '*');
+  assert(ret == E_CCURSOR_OK);
+  assert(payload.buffer_size == strlen(str) - 3);
+  ret = ccursor_rfind_char(&payload, ',');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_read_char(&payload, &status);
+  assert(ret == E_CCURSOR_OK);
+  assert(status == 'A');
+  ret = ccursor_is_empty(&payload);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_trim_right_at_char(&checksum, '*');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+void test_rfind_invalid() {
+  ccursor_ret_t ret;
+  char *str = "abc";
+  ccursor_handle_t handle;
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_rfind_char(NULL, 'a');
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_rfind_substr(&handle, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_trim_right_at_char(&handle, 'x');
+  assert(ret == E_CCURSOR_ERR_PARSE);
+  assert(handle.buffer_size == 3);
+}
+
+int main() {
+  test_rfind_char();
+  test_rfind_substr();
+  test_rfind_nmea();
+  test_rfind_invalid();
+  return 0;
+}
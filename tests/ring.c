@@ -0,0 +1,184 @@
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ccursor_ring.h"
+
+#define TEST_CAPACITY 64
+#define TEST_THREAD_CAPACITY 1024
+#define TEST_NUMBERS 20000
+
+static ccursor_ring_t ring;
+static char storage[TEST_THREAD_CAPACITY];
+
+void test_ring_wraparound() {
+  ccursor_ret_t ret;
+  ret = ccursor_ring_init(&ring, storage, TEST_CAPACITY);
+  assert(ret == E_CCURSOR_OK);
+
+  ccursor_ring_view_t view;
+  ret = ccursor_ring_peek(&ring, &view);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+
+  // test the producer writes into the reserved segments directly
+  struct iovec segments[2];
+  size_t size = 0;
+  ret = ccursor_ring_reserve(&ring, segments, &size);
+  assert(ret == E_CCURSOR_OK);
+  assert(size == TEST_CAPACITY);
+  assert(segments[0].iov_len == TEST_CAPACITY && segments[1].iov_len == 0);
+  memset(segments[0].iov_base, ' ', 60);
+  ret = ccursor_ring_commit(&ring, 60);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_ring_peek(&ring, &view);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_ring_release(&ring, 60);
+  assert(ret == E_CCURSOR_OK);
+
+  // test a token straddling the wraparound
+  ret = ccursor_ring_write(&ring, "12345,6789", 10, &size);
+  assert(ret == E_CCURSOR_OK);
+  assert(size == 10);
+  ret = ccursor_ring_peek(&ring, &view);
+  assert(ret == E_CCURSOR_OK);
+  assert(view.segments[0].iov_len == 4 && view.segments[1].iov_len == 6);
+
+  uint32_t value = 0;
+  ret = ccursor_iovec_read_u32(&view.cursor, &value);
+  assert(ret == E_CCURSOR_OK);
+  assert(value == 12345);
+  ret = ccursor_iovec_skip_char(&view.cursor, ',');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_ring_release(&ring, ccursor_iovec_position(&view.cursor));
+  assert(ret == E_CCURSOR_OK);
+
+  // test a full ring
+  char fill[TEST_CAPACITY] = {0};
+  ret = ccursor_ring_write(&ring, fill, TEST_CAPACITY, &size);
+  assert(ret == E_CCURSOR_OK);
+  assert(size == 60);
+  ret = ccursor_ring_reserve(&ring, segments, &size);
+  assert(ret == E_CCURSOR_OK);
+  assert(size == 0);
+  ret = ccursor_ring_commit(&ring, 1);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_peek(&ring, &view);
+  assert(ret == E_CCURSOR_OK);
+  assert(ccursor_iovec_available(&view.cursor) == TEST_CAPACITY);
+  ret = ccursor_ring_release(&ring, TEST_CAPACITY + 1);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_release(&ring, TEST_CAPACITY);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_ring_peek(&ring, &view);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+}
+
+static void *produce(void *arg) {
+  (void)arg;
+  char line[16];
+  for (uint32_t number = 0; number < TEST_NUMBERS; number++) {
+    size_t length = (size_t)snprintf(line, sizeof(line), "%u\n", number);
+    size_t written = 0;
+    while (written < length) {
+      size_t size = 0;
+      ccursor_ret_t ret =
+          ccursor_ring_write(&ring, line + written, length - written, &size);
+      assert(ret == E_CCURSOR_OK);
+      written += size;
+      if (written < length) {
+        sched_yield();
+      }
+    }
+  }
+  return NULL;
+}
+
+void test_ring_threads() {
+  ccursor_ret_t ret;
+  ret = ccursor_ring_init(&ring, storage, TEST_THREAD_CAPACITY);
+  assert(ret == E_CCURSOR_OK);
+
+  pthread_t producer;
+  int result = pthread_create(&producer, NULL, produce, NULL);
+  assert(result == 0);
+
+  // test the consumer parses the complete lines and releases them
+  uint32_t expected = 0;
+  while (expected < TEST_NUMBERS) {
+    ccursor_ring_view_t view;
+    if (ccursor_ring_peek(&ring, &view) != E_CCURSOR_OK) {
+      sched_yield();
+      continue;
+    }
+
+    size_t complete = 0;
+    uint32_t value = 0;
+    while (ccursor_iovec_read_u32(&view.cursor, &value) == E_CCURSOR_OK &&
+           ccursor_iovec_skip_char(&view.cursor, '\n') == E_CCURSOR_OK) {
+      assert(value == expected);
+      expected++;
+      complete = ccursor_iovec_position(&view.cursor);
+    }
+    ret = ccursor_ring_release(&ring, complete);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  result = pthread_join(producer, NULL);
+  assert(result == 0);
+  ccursor_ring_view_t view;
+  ret = ccursor_ring_peek(&ring, &view);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+}
+
+void test_ring_invalid() {
+  ccursor_ret_t ret;
+  ccursor_ring_t invalid;
+  ret = ccursor_ring_init(&invalid, storage, 48);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_init(&invalid, NULL, 64);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_init(NULL, storage, 64);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_peek(&ring, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  struct iovec segments[2];
+  size_t size = 0;
+  ret = ccursor_ring_reserve(NULL, segments, &size);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_reserve(&ring, NULL, &size);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_commit(NULL, 0);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_write(NULL, "1", 1, &size);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_write(&ring, NULL, 1, &size);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_write(&ring, "1", 1, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_release(NULL, 0);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+
+  // test an empty ring accepts neither a commit beyond its capacity nor a
+  // release
+  ret = ccursor_ring_init(&invalid, storage, TEST_CAPACITY);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_ring_commit(&invalid, TEST_CAPACITY + 1);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_release(&invalid, 1);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_ring_reserve(&invalid, segments, NULL);
+  assert(ret == E_CCURSOR_OK);
+  assert(segments[0].iov_len == TEST_CAPACITY);
+}
+
+int main() {
+  test_ring_wraparound();
+  test_ring_threads();
+  test_ring_invalid();
+  return 0;
+}
@@ -0,0 +1,120 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_subview_nested() {
+  ccursor_ret_t ret;
+  // test parsing a bracketed structure in place
+  char *str = "+CGDCONT: (1,\"IP\",\"web\",2),(3,\"IPV6\",\"ims\",4)\r\n";
+  ccursor_handle_t handle;
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_skip_substr(&handle, "+CGDCONT: ");
+  assert(ret == E_CCURSOR_OK);
+
+  uint32_t cids[2] = {0};
+  char types[2][8] = {{0}};
+  for (size_t idx = 0; idx < 2; idx++) {
+    if (idx > 0) {
+      ret = ccursor_skip_char(&handle, ',');
+      assert(ret == E_CCURSOR_OK);
+    }
+    ret = ccursor_skip_char(&handle, '(');
+    assert(ret == E_CCURSOR_OK);
+
+    ccursor_handle_t context;
+    ret = ccursor_split_at_char(&handle, ')', &context);
+    assert(ret == E_CCURSOR_OK);
+    assert(context.read_position == handle.read_position);
+
+    size_t written = 0;
+    ret = ccursor_read_u32(&context, &cids[idx]);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_substr(&context, ",\"");
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_read_substr_until_char(&context, types[idx],
+                                         sizeof(types[idx]), '"', &written);
+    assert(ret == E_CCURSOR_OK);
+
+    // the child ends in front of the ')', also for the searches
+    ret = ccursor_skip_until_char(&context, ')');
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    ret = ccursor_rfind_char(&context, ',');
+    assert(ret == E_CCURSOR_OK);
+    uint32_t last = 0;
+    ret = ccursor_read_u32(&context, &last);
+    assert(ret == E_CCURSOR_OK);
+    assert(last == cids[idx] + 1);
+    ret = ccursor_is_empty(&context);
+    assert(ret == E_CCURSOR_OK);
+
+    ret = ccursor_commit(&handle, &context);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_skip_char(&handle, ')');
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  assert(cids[0] == 1 && cids[1] == 3);
+  assert(strcmp(types[0], "IP") == 0 && strcmp(types[1], "IPV6") == 0);
+  ret = ccursor_skip_substr(&handle, "\r\n");
+  assert(ret == E_CCURSOR_OK);
+}
+
+void test_subview_bounds() {
+  ccursor_ret_t ret;
+  char *str = "12345,678";
+  ccursor_handle_t handle;
+  ccursor_handle_t child;
+  ret = ccursor_init(&handle, str, strlen(str));
+  assert(ret == E_CCURSOR_OK);
+
+  // test a fixed-width field ends the number
+  uint32_t value = 0;
+  ret = ccursor_subview(&handle, 3, &child);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_read_u32(&child, &value);
+  assert(ret == E_CCURSOR_OK);
+  assert(value == 123);
+  assert(handle.read_position == str);
+  ret = ccursor_commit(&handle, &child);
+  assert(ret == E_CCURSOR_OK);
+  assert(handle.read_position == str + 3);
+
+  // test the whole remaining stream and beyond
+  ret = ccursor_subview(&handle, 6, &child);
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_subview(&handle, 7, &child);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+  ret = ccursor_subview(&handle, 0, &child);
+  assert(ret == E_CCURSOR_OK);
+  assert(ccursor_available(&child) == 0);
+
+  // test an empty child in front of the character
+  ret = ccursor_skip_until_char(&handle, '5');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_split_at_char(&handle, ',', &child);
+  assert(ret == E_CCURSOR_OK);
+  assert(child.buffer_size == 0);
+  ret = ccursor_split_at_char(&handle, ';', &child);
+  assert(ret == E_CCURSOR_ERR_PARSE);
+
+  // test a child behind the parent cannot be committed
+  ccursor_handle_t behind = handle;
+  ret = ccursor_skip_char(&handle, ',');
+  assert(ret == E_CCURSOR_OK);
+  ret = ccursor_commit(&handle, &behind);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_commit(NULL, &behind);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_subview(&handle, 1, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+int main() {
+  test_subview_nested();
+  test_subview_bounds();
+  return 0;
+}
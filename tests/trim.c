@@ -0,0 +1,115 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+void test_trim_whitespace() {
+  ccursor_ret_t ret;
+  // test all whitespace characters are trimmed from both ends
+  {
+    char str[] = " \t\v\f+CSQ: 21,99 \r\n";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_trim(&handle, NULL);
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.read_position == str + 4);
+    assert(ccursor_available(&handle) == 11);
+    assert(memcmp(handle.read_position, "+CSQ: 21,99", 11) == 0);
+    assert(strcmp(str, " \t\v\f+CSQ: 21,99 \r\n") == 0);
+  }
+
+  // test the space-only trim is unchanged
+  {
+    char *str = " \tOK";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_trim_left(&handle);
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.read_position == str + 1);
+    ret = ccursor_trim_left_ws(&handle, NULL);
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.read_position == str + 2);
+  }
+
+  // test a stream of whitespace only is trimmed to empty
+  {
+    char *str = " \r\n\t ";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_trim_right(&handle, NULL);
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.buffer_size == 0);
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_trim(&handle, NULL);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_trim(&handle, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
+}
+
+void test_trim_padding() {
+  ccursor_ret_t ret;
+  // test trimming a custom class at every position of every length, the
+  // lengths cover the block sizes of all kernels plus their heads
+  ccursor_charset_t padding;
+  ret = ccursor_charset_init(&padding, "0_");
+  assert(ret == E_CCURSOR_OK);
+
+  char str[200];
+  for (size_t length = 2; length <= sizeof(str); length++) {
+    for (size_t at = 0; at < length; at += (length > 70 ? 5 : 1)) {
+      // padding in front of the cursor must not be trimmed
+      memset(str, '_', sizeof(str));
+      str[at] = '7';
+      ccursor_handle_t handle = {
+          .buffer = str, .buffer_size = length, .read_position = str + 1};
+
+      ret = ccursor_trim_right(&handle, &padding);
+      assert(ret == E_CCURSOR_OK);
+      if (at == 0) {
+        assert(handle.buffer_size == 1);
+      } else {
+        assert(handle.buffer_size == at + 1);
+      }
+    }
+  }
+
+  // test the space-only default is not used with a custom class
+  {
+    char *str = "12 00";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+    assert(ret == E_CCURSOR_OK);
+    ret = ccursor_trim_right(&handle, &padding);
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.buffer_size == 3);
+    ret = ccursor_trim_right(&handle, NULL);
+    assert(ret == E_CCURSOR_OK);
+    assert(handle.buffer_size == 2);
+  }
+}
+
+void test_trim_invalid() {
+  ccursor_ret_t ret;
+  ret = ccursor_trim(NULL, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_trim_left_ws(NULL, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+  ret = ccursor_trim_right(NULL, NULL);
+  assert(ret == E_CCURSOR_ERR_PARAM);
+}
+
+int main() {
+  test_trim_whitespace();
+  test_trim_padding();
+  test_trim_invalid();
+  return 0;
+}
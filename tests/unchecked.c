@@ -0,0 +1,110 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccursor_unchecked.h"
+
+void test_reserve() {
+  // test reserving a part of the stream
+  {
+    ccursor_ret_t ret;
+    char *str = "ABCDEF";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ccursor_unchecked_t window;
+    ret = ccursor_reserve(&handle, 4, &window);
+    assert(ret == E_CCURSOR_OK);
+    assert(window.read_position == str);
+    assert(window.end == str + 4);
+    assert(handle.read_position == str + 4);
+    assert(ccursor_available(&handle) == 2);
+  }
+
+  // test reserving more than available
+  {
+    ccursor_ret_t ret;
+    char *str = "ABC";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ccursor_unchecked_t window;
+    ret = ccursor_reserve(&handle, 4, &window);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.read_position == str);
+
+    ret = ccursor_reserve(&handle, 3, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+  }
+}
+
+void test_unchecked_text() {
+  // test a fixed-layout text record
+  {
+    ccursor_ret_t ret;
+    char *str = "20240131;X;0042|rest";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ccursor_unchecked_t window;
+    ret = ccursor_reserve(&handle, 16, &window);
+    assert(ret == E_CCURSOR_OK);
+
+    uint32_t date = ccursor_read_digits_unchecked(&window, 8);
+    assert(date == 20240131);
+    bool skipped = ccursor_skip_char_unchecked(&window, ';');
+    assert(skipped);
+    skipped = ccursor_skip_char_unchecked(&window, 'Y');
+    assert(!skipped);
+    char flag = ccursor_read_char_unchecked(&window);
+    assert(flag == 'X');
+    ccursor_skip_unchecked(&window, 1);
+    uint32_t count = ccursor_read_digits_unchecked(&window, 4);
+    assert(count == 42);
+    uint8_t separator = ccursor_read_byte_unchecked(&window);
+    assert(separator == '|');
+    assert(window.read_position == window.end);
+
+    ret = ccursor_skip_substr(&handle, "rest");
+    assert(ret == E_CCURSOR_OK);
+  }
+}
+
+void test_unchecked_binary() {
+  // test binary integers in both byte orders
+  {
+    ccursor_ret_t ret;
+    char str[] = "\x01\x02\x01\x02\x01\x02\x03\x04\x01\x02\x03\x04"
+                 "\x01\x02\x03\x04\x05\x06\x07\x08"
+                 "\x01\x02\x03\x04\x05\x06\x07\x08";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+
+    ccursor_unchecked_t window;
+    ret = ccursor_reserve(&handle, sizeof(str) - 1, &window);
+    assert(ret == E_CCURSOR_OK);
+
+    uint16_t value16 = ccursor_get_u16_le_unchecked(&window);
+    assert(value16 == 0x0201);
+    value16 = ccursor_get_u16_be_unchecked(&window);
+    assert(value16 == 0x0102);
+    uint32_t value32 = ccursor_get_u32_le_unchecked(&window);
+    assert(value32 == 0x04030201);
+    value32 = ccursor_get_u32_be_unchecked(&window);
+    assert(value32 == 0x01020304);
+    uint64_t value64 = ccursor_get_u64_le_unchecked(&window);
+    assert(value64 == 0x0807060504030201ULL);
+    value64 = ccursor_get_u64_be_unchecked(&window);
+    assert(value64 == 0x0102030405060708ULL);
+    assert(window.read_position == window.end);
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+}
+
+int main() {
+  test_reserve();
+  test_unchecked_text();
+  test_unchecked_binary();
+  return 0;
+}
@@ -0,0 +1,178 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ccursor.h"
+
+static size_t encode_varint(char *buffer, uint64_t value) {
+  size_t size = 0;
+  do {
+    uint8_t byte = value & 0x7F;
+    value >>= 7;
+    buffer[size++] = (char)(byte | (value != 0 ? 0x80 : 0x00));
+  } while (value != 0);
+  return size;
+}
+
+void test_varint_single() {
+  // test protobuf reference encodings
+  {
+    ccursor_ret_t ret;
+    char str[] = "\x01\xAC\x02\xFF\xFF\xFF\xFF\x0F\x96\x01";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+    assert(ret == E_CCURSOR_OK);
+
+    // parse
+    uint32_t value = 0;
+    ret = ccursor_read_varint_u32(&handle, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 1);
+    ret = ccursor_read_varint_u32(&handle, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == 300);
+    ret = ccursor_read_varint_u32(&handle, &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == UINT32_MAX);
+    uint64_t value64 = 0;
+    ret = ccursor_read_varint_u64(&handle, &value64);
+    assert(ret == E_CCURSOR_OK);
+    assert(value64 == 150);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test zigzag encoding
+  {
+    int32_t value = 0;
+    ccursor_ret_t ret = ccursor_read_varint_i32(SINGLE_SHOT("\x03"), &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == -2);
+
+    ret = ccursor_read_varint_i32(SINGLE_SHOT("\xFF\xFF\xFF\xFF\x0F"), &value);
+    assert(ret == E_CCURSOR_OK);
+    assert(value == INT32_MIN);
+
+    int64_t value64 = 0;
+    ret = ccursor_read_varint_i64(
+        SINGLE_SHOT("\xFE\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01"), &value64);
+    assert(ret == E_CCURSOR_OK);
+    assert(value64 == INT64_MAX);
+  }
+
+  // test missing values
+  {
+    ccursor_ret_t ret;
+    char *str = "\x03";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    ret = ccursor_read_varint_i32(&handle, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    ret = ccursor_read_varint_i64(&handle, NULL);
+    assert(ret == E_CCURSOR_ERR_PARAM);
+    assert(handle.buffer == handle.read_position);
+  }
+
+  // test value exceeding 32 bits
+  {
+    ccursor_ret_t ret;
+    char *str = "\xFF\xFF\xFF\xFF\x1F";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint32_t value = 0;
+    ret = ccursor_read_varint_u32(&handle, &value);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(value == 0);
+    assert(handle.buffer == handle.read_position);
+
+    uint64_t value64 = 0;
+    ret = ccursor_read_varint_u64(&handle, &value64);
+    assert(ret == E_CCURSOR_OK);
+    assert(value64 == 0x1FFFFFFFFULL);
+  }
+
+  // test truncated varint
+  {
+    ccursor_ret_t ret;
+    char *str = "\x80\x80";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, strlen(str));
+
+    uint64_t value = 0;
+    ret = ccursor_read_varint_u64(&handle, &value);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.buffer == handle.read_position);
+  }
+}
+
+void test_varint_bulk() {
+  // test mixed lengths, long enough to use the block decoder
+  {
+    ccursor_ret_t ret;
+    char str[512];
+    uint32_t expected[100];
+    size_t size = 0;
+    for (size_t idx = 0; idx < 100; idx++) {
+      expected[idx] = (idx < 40) ? idx : (uint32_t)(idx * idx * idx * 4099);
+      size += encode_varint(str + size, expected[idx]);
+    }
+    str[size] = '\0';
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, size);
+    assert(ret == E_CCURSOR_OK);
+
+    // parse
+    uint32_t values[100];
+    ret = ccursor_read_varints(&handle, values, 100);
+    assert(ret == E_CCURSOR_OK);
+    assert(memcmp(values, expected, sizeof(values)) == 0);
+
+    ret = ccursor_is_empty(&handle);
+    assert(ret == E_CCURSOR_OK);
+  }
+
+  // test fewer varints than requested
+  {
+    ccursor_ret_t ret;
+    char str[64];
+    size_t size = 0;
+    for (size_t idx = 0; idx < 30; idx++) {
+      size += encode_varint(str + size, 1 + idx);
+    }
+    str[size] = '\0';
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, size);
+
+    uint32_t values[31];
+    ret = ccursor_read_varints(&handle, values, 31);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.buffer == handle.read_position);
+
+    ret = ccursor_read_varints(&handle, values, 30);
+    assert(ret == E_CCURSOR_OK);
+    assert(values[29] == 30);
+  }
+
+  // test overlong varint inside a block
+  {
+    ccursor_ret_t ret;
+    char str[] = "\x01\x02\xFF\xFF\xFF\xFF\xFF\x01\x03\x04\x05\x06\x07\x08\x09"
+                 "\x0A\x0B\x0C\x0D\x0E\x0F\x10\x11\x12\x13\x14\x15";
+    ccursor_handle_t handle;
+    ret = ccursor_init(&handle, str, sizeof(str) - 1);
+
+    uint32_t values[8];
+    ret = ccursor_read_varints(&handle, values, 8);
+    assert(ret == E_CCURSOR_ERR_PARSE);
+    assert(handle.buffer == handle.read_position);
+  }
+}
+
+int main() {
+  test_varint_single();
+  test_varint_bulk();
+  return 0;
+}
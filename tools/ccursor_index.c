@@ -0,0 +1,46 @@
+/*
+ * Builds or refreshes the line index sidecar of a file and prints a range
+ * of its lines.
+ *
+ * Usage: ccursor_index FILE [FIRST [COUNT]]
+ *
+ * Without a range the number of lines is printed. FIRST starts at 0, COUNT
+ * defaults to 1.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ccursor_file.h"
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 4) {
+    fprintf(stderr, "usage: %s FILE [FIRST [COUNT]]\n", argv[0]);
+    return 2;
+  }
+
+  ccursor_file_t file;
+  if (ccursor_file_open(&file, argv[1], 0) != E_CCURSOR_OK) {
+    fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+    return 1;
+  }
+
+  if (argc == 2) {
+    printf("%llu lines, %zu samples every %u lines\n",
+           (unsigned long long)file.lines, file.sample_count, file.interval);
+    ccursor_file_close(&file);
+    return 0;
+  }
+
+  uint64_t first = strtoull(argv[2], NULL, 10);
+  uint64_t count = (argc == 4) ? strtoull(argv[3], NULL, 10) : 1;
+  ccursor_handle_t lines;
+  ccursor_ret_t ret = ccursor_file_lines(&file, first, count, &lines);
+  if (ret == E_CCURSOR_OK) {
+    fwrite(lines.buffer, 1, lines.buffer_size, stdout);
+  } else {
+    fprintf(stderr, "%s: no line %llu\n", argv[0], (unsigned long long)first);
+  }
+
+  ccursor_file_close(&file);
+  return (ret == E_CCURSOR_OK) ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+/*
+ * Training workload for profile-guided builds of the ccursor library.
+ *
+ * Generates a deterministic corpus of the input shapes the library is used
+ * for, i.e. modem style response lines, CSV records, number streams, number
+ * lists and binary records, and parses it repeatedly. The printed checksum
+ * keeps the compiler from dropping the work and allows to compare runs.
+ *
+ * Usage: ccursor_train [iterations]
+ */
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ccursor.h"
+
+#define TRAIN_LINES 2048
+#define TRAIN_TEXT_SIZE (TRAIN_LINES * 48)
+#define TRAIN_VALUES 4096
+
+static uint32_t train_seed = 0x12345678;
+
+static uint32_t train_random(void) {
+  train_seed = train_seed * 1664525U + 1013904223U;
+  return train_seed >> 8;
+}
+
+typedef struct {
+  char responses[TRAIN_TEXT_SIZE];
+  uint32_t responses_size;
+  char records[TRAIN_TEXT_SIZE];
+  uint32_t records_size;
+  char stream[TRAIN_TEXT_SIZE];
+  uint32_t stream_size;
+  char list[TRAIN_TEXT_SIZE];
+  uint32_t list_size;
+  char varints[TRAIN_VALUES * 5 + 1];
+  uint32_t varints_size;
+  char words[TRAIN_VALUES * 4 + 1];
+  uint32_t words_size;
+} train_corpus_t;
+
+static uint32_t train_append(char *buffer, uint32_t size, const char *fmt,
+                             ...) {
+  va_list args;
+  va_start(args, fmt);
+  int written = vsnprintf(buffer + size, TRAIN_TEXT_SIZE - size, fmt, args);
+  va_end(args);
+  return (written > 0) ? size + (uint32_t)written : size;
+}
+
+static void train_generate(train_corpus_t *corpus) {
+  memset(corpus, 0, sizeof(*corpus));
+
+  for (uint32_t idx = 0; idx < TRAIN_LINES; idx++) {
+    corpus->responses_size =
+        train_append(corpus->responses, corpus->responses_size,
+                     "+CSQ: %u,%u\r\n+QTEMP: %u.5\r\n", train_random() % 32,
+                     train_random() % 100, train_random() % 90);
+    corpus->records_size = train_append(
+        corpus->records, corpus->records_size, "%u,-%u.%03u,0x%X\n",
+        train_random(), train_random() % 1000, train_random() % 1000,
+        train_random() & 0xFFFF);
+    corpus->stream_size =
+        train_append(corpus->stream, corpus->stream_size, "%u.%02u\n",
+                     train_random() % 100000, train_random() % 100);
+    corpus->list_size =
+        train_append(corpus->list, corpus->list_size, "%u,%u,%u,",
+                     train_random() % 1000, train_random() % 100000,
+                     train_random());
+  }
+  // the lists end with a number, not with a separator
+  corpus->list[--corpus->list_size] = '\0';
+
+  for (uint32_t idx = 0; idx < TRAIN_VALUES; idx++) {
+    uint32_t value = train_random() >> (train_random() % 24);
+    do {
+      uint8_t byte = value & 0x7F;
+      value >>= 7;
+      corpus->varints[corpus->varints_size++] =
+          (char)(value != 0 ? byte | 0x80 : byte);
+    } while (value != 0);
+
+    uint32_t word = train_random();
+    memcpy(corpus->words + corpus->words_size, &word, sizeof(word));
+    corpus->words_size += sizeof(word);
+  }
+}
+
+static uint64_t train_responses(train_corpus_t *corpus) {
+  ccursor_handle_t handle;
+  uint64_t checksum = 0;
+  ccursor_init(&handle, corpus->responses, corpus->responses_size);
+
+  while (ccursor_is_empty(&handle) != E_CCURSOR_OK) {
+    uint8_t rssi = 0;
+    uint8_t ber = 0;
+    float temp = 0;
+    ccursor_ret_t ret = ccursor_skip_substr(&handle, "+CSQ:");
+    ret |= ccursor_read_u8(&handle, &rssi);
+    ret |= ccursor_skip_char(&handle, ',');
+    ret |= ccursor_read_u8(&handle, &ber);
+    ret |= ccursor_skip_until_char(&handle, '\n');
+    ret |= ccursor_skip_until_substr(&handle, "+QTEMP:");
+    ret |= ccursor_read_f32(&handle, &temp);
+    ret |= ccursor_skip_until_char(&handle, '\n');
+    if (!CCURSOR_IS_OK(ret)) {
+      break;
+    }
+    checksum += rssi + ber + (uint64_t)temp;
+  }
+
+  return checksum;
+}
+
+static uint64_t train_records(train_corpus_t *corpus) {
+  ccursor_handle_t handle;
+  uint64_t checksum = 0;
+  ccursor_init(&handle, corpus->records, corpus->records_size);
+
+  while (ccursor_is_empty(&handle) != E_CCURSOR_OK) {
+    uint32_t id = 0;
+    double value = 0;
+    uint32_t flags = 0;
+    char hex[16];
+    size_t written = 0;
+    ccursor_ret_t ret = ccursor_read_u32(&handle, &id);
+    ret |= ccursor_skip_char(&handle, ',');
+    ret |= ccursor_read_f64(&handle, &value);
+    ret |= ccursor_skip_char(&handle, ',');
+    char *field = handle.read_position;
+    ret |= ccursor_read_substr_until_char(&handle, hex, sizeof(hex), '\n',
+                                          &written);
+    ret |= ccursor_read_u32_be(
+        &(ccursor_handle_t){.buffer = field,
+                            .buffer_size = (uint32_t)written,
+                            .read_position = field},
+        &flags);
+    if (!CCURSOR_IS_OK(ret)) {
+      break;
+    }
+    checksum += id + (uint64_t)(value * -1000) + flags;
+  }
+
+  return checksum;
+}
+
+static uint64_t train_numbers(train_corpus_t *corpus) {
+  ccursor_handle_t handle;
+  uint64_t checksum = 0;
+
+  // fused aggregation of the number stream
+  uint32_t histogram[16] = {0};
+  ccursor_stats_t stats = {
+      .scale = 2,
+      .mode = E_CCURSOR_DECIMAL_ROUND,
+      .histogram = histogram,
+      .histogram_buckets = 16,
+      .histogram_min = 0,
+      .histogram_width = 1000000,
+  };
+  ccursor_init(&handle, corpus->stream, corpus->stream_size);
+  ccursor_aggregate_numbers(&handle, '\n', &stats);
+  checksum += stats.count + (uint64_t)stats.sum;
+
+  // the same stream value by value
+  ccursor_init(&handle, corpus->stream, corpus->stream_size);
+  int64_t decimal = 0;
+  while (CCURSOR_IS_OK(ccursor_read_decimal(&handle, 2, E_CCURSOR_DECIMAL_ROUND,
+                                            &decimal))) {
+    checksum += (uint64_t)decimal;
+    ccursor_skip_char(&handle, '\n');
+  }
+
+  // delimited list in chunks
+  static uint32_t values[TRAIN_VALUES];
+  size_t count = 0;
+  ccursor_init(&handle, corpus->list, corpus->list_size);
+  while (CCURSOR_IS_OK(ccursor_read_u32_list(&handle, ',', values,
+                                             TRAIN_VALUES, &count))) {
+    checksum += count + values[count - 1];
+    ccursor_skip_char(&handle, ',');
+  }
+
+  return checksum;
+}
+
+static uint64_t train_binary(train_corpus_t *corpus) {
+  ccursor_handle_t handle;
+  uint64_t checksum = 0;
+  static uint32_t values[TRAIN_VALUES];
+
+  ccursor_init(&handle, corpus->varints, corpus->varints_size);
+  if (CCURSOR_IS_OK(ccursor_read_varints(&handle, values, TRAIN_VALUES))) {
+    checksum += values[0] + values[TRAIN_VALUES - 1];
+  }
+
+  ccursor_init(&handle, corpus->words, corpus->words_size);
+  if (CCURSOR_IS_OK(ccursor_get_array_u32_be(&handle, values, TRAIN_VALUES))) {
+    checksum += values[0] + values[TRAIN_VALUES - 1];
+  }
+
+  ccursor_init(&handle, corpus->words, corpus->words_size);
+  uint16_t half = 0;
+  while (CCURSOR_IS_OK(ccursor_get_u16_le(&handle, &half))) {
+    checksum += half;
+  }
+
+  return checksum;
+}
+
+int main(int argc, char **argv) {
+  long iterations = (argc > 1) ? strtol(argv[1], NULL, 10) : 200;
+  static train_corpus_t corpus;
+  train_generate(&corpus);
+
+  uint64_t checksum = 0;
+  clock_t start = clock();
+  for (long idx = 0; idx < iterations; idx++) {
+    checksum += train_responses(&corpus);
+    checksum += train_records(&corpus);
+    checksum += train_numbers(&corpus);
+    checksum += train_binary(&corpus);
+  }
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  printf("isa=%s iterations=%ld checksum=%llu time=%.3fs\n",
+         ccursor_active_isa(), iterations, (unsigned long long)checksum,
+         seconds);
+  return 0;
+}